@@ -0,0 +1,223 @@
+#ifndef ASCII_CASE_HPP
+#define ASCII_CASE_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ASCII_CASE_X86
+#endif
+
+enum class LetterCase { Upper, Lower };
+
+// Characters converted in place with a changed-mask: bit (pos + i) of `changed` is set for every character
+// that was converted. Blocks of 64 ASCII bytes are converted with SSE2 or AVX2 (picked at runtime);
+// blocks with other bytes (e.g. UTF-8 sequences) go through std::toupper/std::tolower byte by byte,
+// so they are converted exactly as before.
+class AsciiCase
+{
+    using Kernel = bool (*)(char*, LetterCase, uint64_t&);
+
+public:
+    struct Chunk
+    {
+        char* data;
+        size_t size;
+        size_t pos;
+    };
+
+    static char convert(char c, LetterCase target)
+    {
+        const auto uc = static_cast<unsigned char>(c);
+        return static_cast<char>(target == LetterCase::Upper ? std::toupper(uc) : std::tolower(uc));
+    }
+
+    // returns true when any character was converted
+    static bool convert(char* data, size_t size, LetterCase target, std::span<uint64_t> changed, size_t pos)
+    {
+        static const Kernel kernel = select_kernel();
+
+        uint64_t any_changed = 0;
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64)
+        {
+            uint64_t bits;
+            if (!kernel(data + i, target, bits))
+                bits = convert_bytes(data + i, 64, target);
+
+            mark(changed, pos + i, bits);
+            any_changed |= bits;
+        }
+
+        const uint64_t bits = convert_bytes(data + i, size - i, target);
+        mark(changed, pos + i, bits);
+
+        return (any_changed | bits) != 0;
+    }
+
+    // text split among threads at positions aligned to 64, so every mask word is written by one thread
+    static bool convert(std::span<const Chunk> chunks, size_t length, LetterCase target, std::span<uint64_t> changed,
+        size_t thread_count)
+    {
+        thread_count = std::clamp<size_t>(thread_count, 1, length / 64 + 1);
+
+        auto convert_range = [&](size_t first, size_t last) {
+            bool any_changed = false;
+            for (const auto& chunk : chunks)
+            {
+                const size_t begin = std::max(first, chunk.pos);
+                const size_t end = std::min(last, chunk.pos + chunk.size);
+                if (begin < end)
+                    any_changed |= convert(chunk.data + (begin - chunk.pos), end - begin, target, changed, begin);
+            }
+            return any_changed;
+        };
+
+        auto boundary = [&](size_t thread) { return std::min(length, length * thread / thread_count / 64 * 64); };
+
+        std::vector<char> results(thread_count);
+        {
+            std::vector<std::jthread> threads;
+            for (size_t t = 1; t < thread_count; ++t)
+                threads.emplace_back([&, t] { results[t] = convert_range(boundary(t), t + 1 == thread_count ? length : boundary(t + 1)); });
+
+            results[0] = convert_range(0, thread_count == 1 ? length : boundary(1));
+        }
+
+        return std::ranges::any_of(results, [](char result) { return result != 0; });
+    }
+
+private:
+    // bits may start in the middle of a mask word
+    static void mark(std::span<uint64_t> changed, size_t pos, uint64_t bits)
+    {
+        if (bits == 0)
+            return;
+
+        const size_t shift = pos % 64;
+        changed[pos / 64] |= bits << shift;
+        if (shift != 0 && (bits >> (64 - shift)) != 0)
+            changed[pos / 64 + 1] |= bits >> (64 - shift);
+    }
+
+    static uint64_t convert_bytes(char* data, size_t size, LetterCase target)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const char converted = convert(data[i], target);
+            if (converted != data[i])
+            {
+                data[i] = converted;
+                bits |= uint64_t{1} << i;
+            }
+        }
+
+        return bits;
+    }
+
+    // letters of the source case are the range [first, first + 25]; converting flips bit 0x20
+    static char first_letter(LetterCase target)
+    {
+        return target == LetterCase::Upper ? 'a' : 'A';
+    }
+
+    // portable kernel - the compiler can vectorize it, non-ASCII blocks are rejected
+    static bool convert_block(char* data, LetterCase target, uint64_t& bits)
+    {
+        unsigned char high_bits = 0;
+        for (size_t i = 0; i < 64; ++i)
+            high_bits |= static_cast<unsigned char>(data[i]);
+
+        if (high_bits & 0x80)
+            return false;
+
+        const char first = first_letter(target);
+        bits = 0;
+        for (size_t i = 0; i < 64; ++i)
+        {
+            const bool is_letter = static_cast<unsigned char>(data[i] - first) < 26;
+            data[i] = static_cast<char>(data[i] ^ (is_letter ? 0x20 : 0));
+            bits |= uint64_t{is_letter} << i;
+        }
+
+        return true;
+    }
+
+#ifdef ASCII_CASE_X86
+    // bytes are compared as signed - after subtracting (first + 128) letters are the 26 smallest values
+    static bool convert_block_sse2(char* data, LetterCase target, uint64_t& bits)
+    {
+        __m128i blocks[4];
+        __m128i any = _mm_setzero_si128();
+        for (int k = 0; k < 4; ++k)
+        {
+            blocks[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * k));
+            any = _mm_or_si128(any, blocks[k]);
+        }
+
+        if (_mm_movemask_epi8(any) != 0)
+            return false;
+
+        const __m128i offset = _mm_set1_epi8(static_cast<char>(first_letter(target) + 128));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i flip = _mm_set1_epi8(0x20);
+
+        bits = 0;
+        for (int k = 0; k < 4; ++k)
+        {
+            const __m128i is_letter = _mm_cmplt_epi8(_mm_sub_epi8(blocks[k], offset), limit);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + 16 * k), _mm_xor_si128(blocks[k], _mm_and_si128(is_letter, flip)));
+            bits |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(is_letter))} << (16 * k);
+        }
+
+        return true;
+    }
+
+#if defined(__GNUC__)
+    __attribute__((target("avx2"))) static bool convert_block_avx2(char* data, LetterCase target, uint64_t& bits)
+    {
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(low, high)) != 0)
+            return false;
+
+        const __m256i offset = _mm256_set1_epi8(static_cast<char>(first_letter(target) + 128));
+        const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+        const __m256i flip = _mm256_set1_epi8(0x20);
+
+        const __m256i low_letters = _mm256_cmpgt_epi8(limit, _mm256_sub_epi8(low, offset));
+        const __m256i high_letters = _mm256_cmpgt_epi8(limit, _mm256_sub_epi8(high, offset));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), _mm256_xor_si256(low, _mm256_and_si256(low_letters, flip)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + 32), _mm256_xor_si256(high, _mm256_and_si256(high_letters, flip)));
+
+        bits = uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(low_letters))}
+            | uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(high_letters))} << 32;
+        return true;
+    }
+#endif
+#endif
+
+    static Kernel select_kernel()
+    {
+#ifdef ASCII_CASE_X86
+#if defined(__GNUC__)
+        if (__builtin_cpu_supports("avx2"))
+            return convert_block_avx2;
+#endif
+        return convert_block_sse2;
+#else
+        return convert_block;
+#endif
+    }
+};
+
+#endif // ASCII_CASE_HPP
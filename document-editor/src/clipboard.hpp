@@ -1,34 +1,50 @@
 #ifndef CLIPBOARD_HPP
 #define CLIPBOARD_HPP
 
-#include <mutex>
+#include <atomic>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 
+// Content is immutable - set_content() publishes a new string & readers share it by pointer,
+// so pasting takes no mutex & copies no text. Old content lives while someone holds it.
+// (std::atomic<std::shared_ptr> is not lock-free on every library - libstdc++ guards it with a spin bit.)
 class SharedClipboard
 {
-    std::string content_;
-    mutable std::mutex content_mtx_;
+    std::atomic<std::shared_ptr<const std::string>> content_{std::make_shared<const std::string>()};
 
 public:
-    SharedClipboard& instance()
+    static SharedClipboard& instance()
     {
         static SharedClipboard unique_instance;
 
         return unique_instance;
     }
 
-    std::string content() const
+    std::shared_ptr<const std::string> content() const
     {
-        std::lock_guard<std::mutex> lk{content_mtx_};
+        return content_.load(std::memory_order_acquire);
+    }
 
-        return content_;
+    void set_content(std::string content)
+    {
+        content_.store(std::make_shared<const std::string>(std::move(content)), std::memory_order_release);
     }
 
-    void set_content(const std::string& content)
+    // content is assembled from parts (e.g. Document::chunks()) - without a temporary copy
+    void set_content(std::span<const std::string_view> chunks)
     {
-        std::lock_guard<std::mutex> lk{content_mtx_};
+        size_t size = 0;
+        for (auto chunk : chunks)
+            size += chunk.size();
+
+        std::string content;
+        content.reserve(size);
+        for (auto chunk : chunks)
+            content += chunk;
 
-        content_ = content;
+        set_content(std::move(content));
     }
 };
 
@@ -2,13 +2,26 @@
 #define CONSOLE_HPP
 
 #include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
 
 class Console
 {
 public:
     virtual std::string get_line() = 0;
     virtual void print(const std::string& line) = 0;
+
+    // one line given in parts (e.g. Document::chunks()) - joined for consoles that print whole strings only
+    virtual void print_chunks(std::span<const std::string_view> chunks)
+    {
+        std::string line;
+        for (auto chunk : chunks)
+            line += chunk;
+
+        print(line);
+    }
+
     virtual ~Console() = default;
 };
 
@@ -27,6 +40,13 @@ public:
     {
         std::cout << line << std::endl;
     }
+
+    void print_chunks(std::span<const std::string_view> chunks) override
+    {
+        for (auto chunk : chunks)
+            std::cout << chunk;
+        std::cout << std::endl;
+    }
 };
 
 #endif // CONSOLE_HPP
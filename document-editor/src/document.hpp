@@ -1,29 +1,69 @@
 #ifndef DOCUMENT_HPP
 #define DOCUMENT_HPP
 
-#include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
 #include <string>
-#include <cereal/archives/binary.hpp>
-#include <cereal/types/string.hpp>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
 
+#include "ascii_case.hpp"
+#include "piece_table.hpp"
 
+// Mementos are revisions of the document's edit history - each edit is recorded as a delta
+// (position, removed & inserted text; case changes as a mask of changed characters), so undo keeps
+// only what was edited. Deltas older than all live mementos are dropped.
 class Document
 {
-    std::string text_;
+    static constexpr size_t parallel_case_threshold = 8 << 20; // characters - below that one thread is faster
+
+    struct Edit
+    {
+        size_t pos;
+        std::string removed;
+        std::string inserted;
+    };
+
+    struct CaseChange
+    {
+        LetterCase target;
+        std::vector<uint64_t> changed; // bit per character that was converted
+    };
+
+    struct Delta
+    {
+        uint64_t serial;
+        std::variant<Edit, CaseChange> change;
+    };
+
+    PieceTable text_;
+    std::deque<Delta> history_; // deltas of revisions (base_revision_, base_revision_ + size]
+    uint64_t base_revision_{0};
+    uint64_t base_serial_{new_serial()};
+    uint64_t revision_{0};
+    mutable std::vector<std::weak_ptr<const uint64_t>> pins_; // revisions held by mementos
+    size_t trim_threshold_{16};
 
 public:
     class Memento
     {
     private:
-        std::string snapshot_;
+        uint64_t revision_{0};
+        uint64_t serial_{0}; // serial of the last delta - unique in the process, so it tells histories apart
+        std::shared_ptr<const uint64_t> pin_;
 
         friend class Document;
     };
 
-    Document() : text_{}
-    {
-    }
+    Document() = default;
 
     Document(const std::string& text) : text_{text}
     {
@@ -31,58 +71,201 @@ public:
 
     std::string text() const
     {
-        return text_;
+        return text_.str();
+    }
+
+    // text without copying when it is stored in one piece - otherwise use chunks()
+    std::optional<std::string_view> contiguous_text() const
+    {
+        return text_.contiguous();
+    }
+
+    // views of the text in order - valid until the next edit
+    auto chunks() const
+    {
+        return text_.chunks();
     }
 
     size_t length() const
     {
-        return text_.size();
+        return text_.length();
     }
 
     void add_text(const std::string& txt)
     {
-        text_ += txt;
+        replace(text_.length(), 0, txt);
+    }
+
+    void insert(size_t pos, const std::string& text)
+    {
+        replace(pos, 0, text);
+    }
+
+    void erase(size_t pos, size_t count)
+    {
+        replace(pos, count, "");
     }
 
     void to_upper()
     {
-        std::transform(text_.begin(), text_.end(), text_.begin(), [](auto c) { return std::toupper(c); });        
+        change_case(LetterCase::Upper);
     }
 
     void to_lower()
     {
-        std::transform(text_.begin(), text_.end(), text_.begin(), [](auto c) { return std::tolower(c); });
+        change_case(LetterCase::Lower);
     }
 
     void clear()
     {
-        text_.clear();
+        replace(0, text_.length(), "");
     }
 
-    template <typename TSerializer = cereal::BinaryOutputArchive>
     Memento create_memento() const
     {
-        std::stringstream stream;
-        TSerializer oarchive(stream);
-        oarchive(text_);
-
         Memento memento;
-        memento.snapshot_ = stream.str();
+        memento.revision_ = revision_;
+        memento.serial_ = serial_at(revision_);
+        memento.pin_ = std::make_shared<const uint64_t>(revision_);
+        pins_.push_back(memento.pin_);
 
         return memento;
     }
 
-    template <typename TDeserializer = cereal::BinaryInputArchive>
-    void set_memento(Memento& memento)
+    // deltas are undone (or redone) up to the revision of the memento
+    void set_memento(const Memento& memento)
     {
-        std::stringstream stream{memento.snapshot_};
-        TDeserializer iarchive(stream);
-        iarchive(text_);
+        if (memento.revision_ < base_revision_ || memento.revision_ > base_revision_ + history_.size()
+            || serial_at(memento.revision_) != memento.serial_)
+            throw std::invalid_argument("Memento does not belong to the history of the document");
+
+        while (revision_ > memento.revision_)
+        {
+            --revision_;
+            revert(history_[revision_ - base_revision_].change);
+        }
+
+        while (revision_ < memento.revision_)
+        {
+            apply(history_[revision_ - base_revision_].change);
+            ++revision_;
+        }
     }
 
     void replace(size_t start_pos, size_t count, const std::string& text)
     {
+        Edit edit{start_pos, text_.substr(start_pos, count), text};
+        if (edit.removed.empty() && edit.inserted.empty())
+            return;
+
         text_.replace(start_pos, count, text);
+        record(std::move(edit));
+    }
+
+    // number of deltas kept for undo & redo
+    size_t history_size() const
+    {
+        return history_.size();
+    }
+
+private:
+    static LetterCase opposite(LetterCase target)
+    {
+        return target == LetterCase::Upper ? LetterCase::Lower : LetterCase::Upper;
+    }
+
+    void change_case(LetterCase target)
+    {
+        CaseChange change{target, std::vector<uint64_t>((text_.length() + 63) / 64)};
+
+        std::vector<AsciiCase::Chunk> chunks;
+        text_.transform_chunks([&](char* chunk, size_t size, size_t pos) { chunks.push_back({chunk, size, pos}); });
+
+        const size_t thread_count = text_.length() < parallel_case_threshold ? 1 : std::thread::hardware_concurrency();
+        if (AsciiCase::convert(chunks, text_.length(), target, change.changed, thread_count))
+            record(std::move(change));
+    }
+
+    // characters marked in the mask are converted to the target case; words without marks are skipped
+    void convert_changed(const CaseChange& change, LetterCase target)
+    {
+        text_.transform_chunks([&](char* chunk, size_t size, size_t pos) {
+            for (size_t i = 0; i < size;)
+            {
+                const uint64_t word = change.changed[(pos + i) / 64] >> ((pos + i) % 64);
+                const size_t span = std::min(size - i, 64 - (pos + i) % 64);
+                if (word != 0)
+                {
+                    for (size_t j = 0; j < span; ++j)
+                    {
+                        if ((word >> j) & 1)
+                            chunk[i + j] = AsciiCase::convert(chunk[i + j], target);
+                    }
+                }
+                i += span;
+            }
+        });
+    }
+
+    void apply(const std::variant<Edit, CaseChange>& change)
+    {
+        if (const auto* edit = std::get_if<Edit>(&change))
+            text_.replace(edit->pos, edit->removed.size(), edit->inserted);
+        else
+            convert_changed(std::get<CaseChange>(change), std::get<CaseChange>(change).target);
+    }
+
+    void revert(const std::variant<Edit, CaseChange>& change)
+    {
+        if (const auto* edit = std::get_if<Edit>(&change))
+            text_.replace(edit->pos, edit->inserted.size(), edit->removed);
+        else
+            convert_changed(std::get<CaseChange>(change), opposite(std::get<CaseChange>(change).target));
+    }
+
+    // serials are shared by all documents - a memento of another document never matches
+    static uint64_t new_serial()
+    {
+        static std::atomic<uint64_t> next_serial{1};
+        return next_serial.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t serial_at(uint64_t revision) const
+    {
+        return revision == base_revision_ ? base_serial_ : history_[revision - base_revision_ - 1].serial;
+    }
+
+    // redo tail is dropped; so are deltas no memento can return to
+    void record(std::variant<Edit, CaseChange> change)
+    {
+        history_.resize(revision_ - base_revision_);
+        history_.push_back(Delta{new_serial(), std::move(change)});
+        ++revision_;
+
+        if (history_.size() >= trim_threshold_)
+            trim_history();
+    }
+
+    // pins are checked only when history doubled since the last trim - amortized O(1) per edit
+    void trim_history()
+    {
+        std::erase_if(pins_, [](const auto& pin) { return pin.expired(); });
+
+        uint64_t oldest_needed = revision_;
+        for (const auto& pin : pins_)
+        {
+            if (auto revision = pin.lock())
+                oldest_needed = std::min(oldest_needed, *revision);
+        }
+
+        while (base_revision_ < oldest_needed)
+        {
+            base_serial_ = history_.front().serial;
+            history_.pop_front();
+            ++base_revision_;
+        }
+
+        trim_threshold_ = 2 * history_.size() + 16;
     }
 };
 
@@ -0,0 +1,437 @@
+#ifndef PIECE_TABLE_HPP
+#define PIECE_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Text stored as a sequence of pieces - slices of the original text & of append-only add buffers.
+// Pieces are kept in a treap ordered by position & augmented with subtree lengths, so insert, erase
+// & replace split and merge O(log n) nodes instead of moving the text behind the edit.
+class PieceTable
+{
+    static constexpr uint32_t nil = UINT32_MAX;
+    static constexpr size_t add_buffer_capacity = 1 << 20;
+
+    struct Piece
+    {
+        uint32_t buffer;
+        size_t start;
+        size_t length;
+    };
+
+    struct Node
+    {
+        Piece piece;
+        uint32_t priority;
+        uint32_t left{nil};
+        uint32_t right{nil};
+        size_t subtree_length;
+    };
+
+    std::vector<std::string> buffers_; // [0] - original text; add buffers are never reallocated
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_nodes_;
+    uint32_t root_{nil};
+    uint64_t random_state_{0x9e3779b97f4a7c15};
+
+public:
+    // forward iterator over pieces as string_views - each step finds the next piece in O(log n)
+    class ChunkIterator
+    {
+        const PieceTable* table_{nullptr};
+        size_t pos_{0};
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        ChunkIterator() = default;
+
+        ChunkIterator(const PieceTable& table, size_t pos) : table_{&table}, pos_{pos}
+        {
+        }
+
+        std::string_view operator*() const
+        {
+            return table_->chunk_at(pos_);
+        }
+
+        ChunkIterator& operator++()
+        {
+            pos_ += table_->chunk_at(pos_).size();
+            return *this;
+        }
+
+        ChunkIterator operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ChunkIterator& other) const
+        {
+            return pos_ == other.pos_;
+        }
+    };
+
+    PieceTable() = default;
+
+    explicit PieceTable(std::string text)
+    {
+        assign(std::move(text));
+    }
+
+    size_t length() const
+    {
+        return subtree_length(root_);
+    }
+
+    bool empty() const
+    {
+        return root_ == nil;
+    }
+
+    size_t piece_count() const
+    {
+        return nodes_.size() - free_nodes_.size();
+    }
+
+    // replaces everything - text becomes the original buffer
+    void assign(std::string text)
+    {
+        buffers_.clear();
+        nodes_.clear();
+        free_nodes_.clear();
+        root_ = nil;
+
+        buffers_.push_back(std::move(text));
+        if (!buffers_[0].empty())
+            root_ = new_node(Piece{0, 0, buffers_[0].size()});
+    }
+
+    void clear()
+    {
+        assign(std::string{});
+    }
+
+    void insert(size_t pos, std::string_view text)
+    {
+        if (pos > length())
+            throw std::out_of_range("Position out of range");
+
+        if (text.empty())
+            return;
+
+        auto [left, right] = split(root_, pos);
+        const Piece piece = append_to_add_buffer(text);
+
+        if (!try_extend_last_piece(left, piece))
+            left = merge(left, new_node(piece));
+
+        root_ = merge(left, right);
+    }
+
+    void erase(size_t pos, size_t count)
+    {
+        if (pos > length())
+            throw std::out_of_range("Position out of range");
+
+        count = std::min(count, length() - pos);
+        if (count == 0)
+            return;
+
+        auto [left, rest] = split(root_, pos);
+        auto [erased, right] = split(rest, count);
+        free_subtree(erased);
+
+        root_ = merge(left, right);
+    }
+
+    void replace(size_t pos, size_t count, std::string_view text)
+    {
+        erase(pos, count);
+        insert(pos, text);
+    }
+
+    // views of pieces in order; views stay valid until the next edit
+    auto chunks() const
+    {
+        return std::ranges::subrange{ChunkIterator{*this, 0}, ChunkIterator{*this, length()}};
+    }
+
+    // the whole text when it is a single piece (or empty) - no copy is made
+    std::optional<std::string_view> contiguous() const
+    {
+        if (root_ == nil)
+            return std::string_view{};
+
+        const Node& root = nodes_[root_];
+        if (root.left != nil || root.right != nil)
+            return std::nullopt;
+
+        return view_of(root.piece);
+    }
+
+    // f(std::string_view) is called for pieces in order; views stay valid until the next edit
+    template <typename F>
+    void for_each_chunk(F&& f) const
+    {
+        for_each_piece_in_order([&](const Piece& piece) { f(view_of(piece)); });
+    }
+
+    // f(char* chunk, size_t size, size_t pos) may change characters of pieces in place (e.g. case conversion);
+    // pieces are visited in order, pos is the position of the chunk in the text
+    template <typename F>
+    void transform_chunks(F&& f)
+    {
+        size_t pos = 0;
+        for_each_piece_in_order([&](const Piece& piece) {
+            f(buffers_[piece.buffer].data() + piece.start, piece.length, pos);
+            pos += piece.length;
+        });
+    }
+
+    std::string substr(size_t pos, size_t count) const
+    {
+        if (pos > length())
+            throw std::out_of_range("Position out of range");
+
+        count = std::min(count, length() - pos);
+
+        std::string text;
+        text.reserve(count);
+        while (text.size() < count)
+        {
+            const auto chunk = chunk_at(pos + text.size());
+            text += chunk.substr(0, count - text.size());
+        }
+
+        return text;
+    }
+
+    std::string str() const
+    {
+        std::string text;
+        text.reserve(length());
+        for_each_chunk([&text](std::string_view chunk) { text += chunk; });
+
+        return text;
+    }
+
+private:
+    template <typename F>
+    void for_each_piece_in_order(F&& f) const
+    {
+        std::vector<uint32_t> path;
+        uint32_t node = root_;
+
+        while (node != nil || !path.empty())
+        {
+            for (; node != nil; node = nodes_[node].left)
+                path.push_back(node);
+
+            node = path.back();
+            path.pop_back();
+
+            f(nodes_[node].piece);
+
+            node = nodes_[node].right;
+        }
+    }
+
+    std::string_view view_of(const Piece& piece) const
+    {
+        return std::string_view{buffers_[piece.buffer]}.substr(piece.start, piece.length);
+    }
+
+    // rest of the piece containing pos
+    std::string_view chunk_at(size_t pos) const
+    {
+        uint32_t node = root_;
+        while (node != nil)
+        {
+            const size_t left_length = subtree_length(nodes_[node].left);
+            const Piece& piece = nodes_[node].piece;
+
+            if (pos < left_length)
+            {
+                node = nodes_[node].left;
+            }
+            else if (pos < left_length + piece.length)
+            {
+                return view_of(piece).substr(pos - left_length);
+            }
+            else
+            {
+                pos -= left_length + piece.length;
+                node = nodes_[node].right;
+            }
+        }
+
+        return {};
+    }
+
+    size_t subtree_length(uint32_t node) const
+    {
+        return node == nil ? 0 : nodes_[node].subtree_length;
+    }
+
+    void update(uint32_t node)
+    {
+        Node& n = nodes_[node];
+        n.subtree_length = subtree_length(n.left) + n.piece.length + subtree_length(n.right);
+    }
+
+    uint32_t next_priority()
+    {
+        random_state_ ^= random_state_ << 13;
+        random_state_ ^= random_state_ >> 7;
+        random_state_ ^= random_state_ << 17;
+        return static_cast<uint32_t>(random_state_ >> 32);
+    }
+
+    uint32_t new_node(const Piece& piece)
+    {
+        const Node node{piece, next_priority(), nil, nil, piece.length};
+
+        if (!free_nodes_.empty())
+        {
+            const uint32_t index = free_nodes_.back();
+            free_nodes_.pop_back();
+            nodes_[index] = node;
+            return index;
+        }
+
+        nodes_.push_back(node);
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void free_subtree(uint32_t node)
+    {
+        std::vector<uint32_t> pending;
+        if (node != nil)
+            pending.push_back(node);
+
+        while (!pending.empty())
+        {
+            const uint32_t current = pending.back();
+            pending.pop_back();
+
+            if (nodes_[current].left != nil)
+                pending.push_back(nodes_[current].left);
+            if (nodes_[current].right != nil)
+                pending.push_back(nodes_[current].right);
+
+            nodes_[current].piece.length = 0;
+            free_nodes_.push_back(current);
+        }
+    }
+
+    // first pos characters go to the left tree - a piece containing the split point is cut in two
+    std::pair<uint32_t, uint32_t> split(uint32_t node, size_t pos)
+    {
+        if (node == nil)
+            return {nil, nil};
+
+        const size_t left_length = subtree_length(nodes_[node].left);
+        const size_t piece_length = nodes_[node].piece.length;
+
+        if (pos <= left_length)
+        {
+            auto [left, right] = split(nodes_[node].left, pos);
+            nodes_[node].left = right;
+            update(node);
+            return {left, node};
+        }
+
+        if (pos >= left_length + piece_length)
+        {
+            auto [left, right] = split(nodes_[node].right, pos - left_length - piece_length);
+            nodes_[node].right = left;
+            update(node);
+            return {node, right};
+        }
+
+        const size_t offset = pos - left_length;
+        Piece tail = nodes_[node].piece;
+        tail.start += offset;
+        tail.length -= offset;
+        nodes_[node].piece.length = offset;
+
+        const uint32_t tail_node = new_node(tail);
+        const uint32_t right = merge(tail_node, nodes_[node].right);
+        nodes_[node].right = nil;
+        update(node);
+
+        return {node, right};
+    }
+
+    uint32_t merge(uint32_t left, uint32_t right)
+    {
+        if (left == nil)
+            return right;
+        if (right == nil)
+            return left;
+
+        if (nodes_[left].priority > nodes_[right].priority)
+        {
+            nodes_[left].right = merge(nodes_[left].right, right);
+            update(left);
+            return left;
+        }
+
+        nodes_[right].left = merge(left, nodes_[right].left);
+        update(right);
+        return right;
+    }
+
+    Piece append_to_add_buffer(std::string_view text)
+    {
+        if (buffers_.size() == 1 || buffers_.back().capacity() - buffers_.back().size() < text.size())
+        {
+            buffers_.emplace_back();
+            buffers_.back().reserve(std::max(add_buffer_capacity, text.size()));
+        }
+
+        std::string& buffer = buffers_.back();
+        const Piece piece{static_cast<uint32_t>(buffers_.size() - 1), buffer.size(), text.size()};
+        buffer.append(text);
+
+        return piece;
+    }
+
+    // typing at the same place continues the last piece instead of adding a node per insert
+    bool try_extend_last_piece(uint32_t tree, const Piece& piece)
+    {
+        if (tree == nil)
+            return false;
+
+        uint32_t last = tree;
+        while (nodes_[last].right != nil)
+            last = nodes_[last].right;
+
+        Piece& last_piece = nodes_[last].piece;
+        if (last_piece.buffer != piece.buffer || last_piece.start + last_piece.length != piece.start)
+            return false;
+
+        last_piece.length += piece.length;
+        for (uint32_t node = tree; node != nil; node = nodes_[node].right)
+            nodes_[node].subtree_length += piece.length;
+
+        return true;
+    }
+};
+
+#endif // PIECE_TABLE_HPP
@@ -1,6 +1,11 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "clipboard.hpp"
 #include "document.hpp"
 #include "mocks/mocks.hpp"
 
@@ -10,4 +15,83 @@ using namespace std::literals;
 TEST(ApplicationTests, TODO)
 {
     //FAIL();
-}
\ No newline at end of file
+}
+
+TEST(Console_PrintingChunks, ChunksArePrintedAsOneLine)
+{
+    MockConsole console;
+    const std::vector<std::string_view> chunks{"ab", "c", "def"};
+
+    EXPECT_CALL(console, print("abcdef"s));
+
+    console.print_chunks(chunks);
+}
+
+TEST(SharedClipboard_CopyingChunks, ContentIsJoined)
+{
+    SharedClipboard clipboard;
+    Document doc{"abc"};
+    doc.add_text("def");
+
+    const std::vector<std::string_view> chunks(doc.chunks().begin(), doc.chunks().end());
+    clipboard.set_content(chunks);
+
+    ASSERT_THAT(clipboard.content(), Pointee(StrEq("abcdef")));
+}
+
+TEST(SharedClipboard_Instance, IsSharedByCallers)
+{
+    SharedClipboard::instance().set_content("copied");
+
+    ASSERT_THAT(&SharedClipboard::instance(), Eq(&SharedClipboard::instance()));
+    ASSERT_THAT(SharedClipboard::instance().content(), Pointee(StrEq("copied")));
+}
+
+TEST(SharedClipboard_Pasting, ContentIsSharedNotCopied)
+{
+    SharedClipboard clipboard;
+    clipboard.set_content(std::string(1 << 20, 'x'));
+
+    auto first_paste = clipboard.content();
+    auto second_paste = clipboard.content();
+
+    ASSERT_THAT(first_paste.get(), Eq(second_paste.get()));
+}
+
+TEST(SharedClipboard_Pasting, PastedContentOutlivesNextCopy)
+{
+    SharedClipboard clipboard;
+    clipboard.set_content("first");
+    auto pasted = clipboard.content();
+
+    clipboard.set_content("second");
+
+    ASSERT_THAT(pasted, Pointee(StrEq("first")));
+    ASSERT_THAT(clipboard.content(), Pointee(StrEq("second")));
+}
+
+TEST(SharedClipboard_Pasting, ReadersSeeWholeContentWhileCopying)
+{
+    SharedClipboard clipboard;
+    std::atomic<bool> torn{false};
+
+    {
+        std::vector<std::jthread> readers;
+        for (int i = 0; i < 3; ++i)
+        {
+            readers.emplace_back([&](std::stop_token stop) {
+                while (!stop.stop_requested())
+                {
+                    const auto content = clipboard.content();
+                    if (!content->empty() && content->find_first_not_of(content->front()) != std::string::npos)
+                        torn = true;
+                }
+            });
+        }
+
+        for (int i = 0; i < 1000; ++i)
+            clipboard.set_content(std::string(1000, static_cast<char>('a' + i % 26)));
+    }
+
+    ASSERT_THAT(torn.load(), IsFalse());
+}
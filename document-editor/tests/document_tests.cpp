@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cctype>
+#include <random>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -82,6 +84,79 @@ TEST_F(Document_CaseConversion, ToLowerCase)
     ASSERT_THAT(doc.text(), StrEq("abcdef"));
 }
 
+TEST_F(Document_CaseConversion, NonAsciiBytesAreLeftUnchanged)
+{
+    Document utf8{"za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 g\xc4\x99\xc5\x9bl\xc4\x85 ja\xc5\xba\xc5\x84"};
+
+    utf8.to_upper();
+
+    ASSERT_THAT(utf8.text(), StrEq("ZA\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 G\xc4\x99\xc5\x9bL\xc4\x85 JA\xc5\xba\xc5\x84"));
+}
+
+namespace
+{
+    std::string converted(std::string text, int (*convert)(int))
+    {
+        std::ranges::transform(text, text.begin(), [convert](char c) { return static_cast<char>(convert(static_cast<unsigned char>(c))); });
+        return text;
+    }
+
+    std::string random_text(size_t length, uint32_t seed)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<int> byte{0, 255};
+
+        std::string text(length, ' ');
+        for (size_t i = 0; i < length; ++i)
+            text[i] = static_cast<char>(i % 300 < 250 ? byte(engine) % 128 : byte(engine)); // mostly ASCII blocks
+        return text;
+    }
+}
+
+TEST_F(Document_CaseConversion, EditedLongTextIsConvertedLikeCharByChar)
+{
+    Document long_doc{random_text(10'000, 1)};
+    long_doc.insert(17, "mIxEd CaSe");
+    long_doc.erase(333, 5);
+    long_doc.insert(4001, random_text(200, 2));
+    const std::string text = long_doc.text();
+
+    long_doc.to_upper();
+    ASSERT_THAT(long_doc.text() == converted(text, std::toupper), IsTrue());
+
+    long_doc.to_lower();
+    ASSERT_THAT(long_doc.text() == converted(text, std::tolower), IsTrue());
+}
+
+TEST_F(Document_CaseConversion, ThreadsMarkTheSameCharactersAsOneThread)
+{
+    std::string text = random_text(100'003, 3);
+    std::string single_threaded = text;
+
+    const std::vector<AsciiCase::Chunk> chunks{{text.data(), 777, 0}, {text.data() + 777, text.size() - 777, 777}};
+    std::vector<uint64_t> changed((text.size() + 63) / 64);
+    std::vector<uint64_t> expected_changed(changed.size());
+
+    AsciiCase::convert(chunks, text.size(), LetterCase::Upper, changed, 4);
+    AsciiCase::convert(single_threaded.data(), single_threaded.size(), LetterCase::Upper, expected_changed, 0);
+
+    ASSERT_THAT(text == single_threaded, IsTrue());
+    ASSERT_THAT(changed, ContainerEq(expected_changed));
+}
+
+TEST_F(Document_CaseConversion, UndoRestoresEditedLongText)
+{
+    Document long_doc{random_text(5'000, 4)};
+    long_doc.insert(1234, "Some More Text");
+    const std::string text = long_doc.text();
+    auto before = long_doc.create_memento();
+
+    long_doc.to_lower();
+    long_doc.set_memento(before);
+
+    ASSERT_THAT(long_doc.text() == text, IsTrue());
+}
+
 struct Document_ReplacingText : Document_ValueConstructed
 {
 };
@@ -104,4 +179,137 @@ TEST_F(Document_Memento, RestoresThePreviousState)
     doc.set_memento(snaphot);
 
     ASSERT_THAT(doc.text(), StrEq("abc"));
-}
\ No newline at end of file
+}
+struct Document_EditingInTheMiddle : Document_ValueConstructed
+{
+};
+
+TEST_F(Document_EditingInTheMiddle, TextIsInserted)
+{
+    doc.insert(1, "xyz");
+
+    ASSERT_THAT(doc.text(), StrEq("axyzbc"));
+}
+
+TEST_F(Document_EditingInTheMiddle, TextIsErased)
+{
+    doc.erase(1, 1);
+
+    ASSERT_THAT(doc.text(), StrEq("ac"));
+}
+
+struct Document_TextAccess : Document_ValueConstructed
+{
+};
+
+TEST_F(Document_TextAccess, SinglePieceIsViewedWithoutCopy)
+{
+    ASSERT_THAT(doc.contiguous_text(), Optional(Eq("abc")));
+}
+
+TEST_F(Document_TextAccess, EditedTextIsViewedInChunks)
+{
+    doc.add_text("def");
+    doc.insert(1, "X");
+
+    std::string joined;
+    for (auto chunk : doc.chunks())
+        joined += chunk;
+
+    ASSERT_THAT(doc.contiguous_text(), Eq(std::nullopt));
+    ASSERT_THAT(joined, StrEq("aXbcdef"));
+}
+
+struct Document_Undo : Test
+{
+    Document doc{"abc"};
+};
+
+TEST_F(Document_Undo, EditsAreUndoneInReverseOrder)
+{
+    auto initial = doc.create_memento();
+    doc.add_text("def");
+    auto after_add = doc.create_memento();
+    doc.replace(1, 3, "XY");
+    doc.erase(0, 1);
+
+    doc.set_memento(after_add);
+    ASSERT_THAT(doc.text(), StrEq("abcdef"));
+
+    doc.set_memento(initial);
+    ASSERT_THAT(doc.text(), StrEq("abc"));
+}
+
+TEST_F(Document_Undo, UndoneEditsAreRedone)
+{
+    auto initial = doc.create_memento();
+    doc.insert(1, "123");
+    auto edited = doc.create_memento();
+
+    doc.set_memento(initial);
+    doc.set_memento(edited);
+
+    ASSERT_THAT(doc.text(), StrEq("a123bc"));
+}
+
+TEST_F(Document_Undo, CaseChangeRestoresMixedCase)
+{
+    Document mixed{"aBc dEf"};
+    auto before = mixed.create_memento();
+
+    mixed.to_upper();
+    mixed.set_memento(before);
+
+    ASSERT_THAT(mixed.text(), StrEq("aBc dEf"));
+}
+
+TEST_F(Document_Undo, MementoOfDiscardedRedoIsRejected)
+{
+    auto initial = doc.create_memento();
+    doc.add_text("def");
+    auto discarded = doc.create_memento();
+    doc.set_memento(initial);
+    doc.add_text("xyz");
+
+    ASSERT_THROW(doc.set_memento(discarded), std::invalid_argument);
+}
+
+TEST_F(Document_Undo, MementoOfAnotherDocumentIsRejected)
+{
+    Document other{"abc"};
+    auto other_initial = other.create_memento();
+    other.add_text("def");
+    auto other_edited = other.create_memento();
+
+    doc.add_text("xyz");
+
+    ASSERT_THROW(doc.set_memento(other_initial), std::invalid_argument);
+    ASSERT_THROW(doc.set_memento(other_edited), std::invalid_argument);
+    ASSERT_THAT(doc.text(), StrEq("abcxyz"));
+}
+
+TEST_F(Document_Undo, HistoryIsDroppedWhenNoMementoNeedsIt)
+{
+    for (int i = 0; i < 1000; ++i)
+        doc.add_text("x");
+
+    ASSERT_THAT(doc.history_size(), Lt(100));
+}
+
+TEST(Document_UndoLargeDocument, ManyStepsKeepOnlyDeltas)
+{
+    const std::string initial(16 << 20, 'x');
+    Document doc{initial};
+    std::vector<Document::Memento> undo_stack;
+
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+        undo_stack.push_back(doc.create_memento());
+        doc.replace(i * 1000, 2, "abc");
+    }
+
+    ASSERT_THAT(doc.history_size(), Eq(10'000));
+
+    doc.set_memento(undo_stack.front());
+    ASSERT_THAT(doc.text() == initial, IsTrue());
+}
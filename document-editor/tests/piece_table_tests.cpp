@@ -0,0 +1,116 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "document.hpp"
+#include "piece_table.hpp"
+
+using namespace ::testing;
+
+struct PieceTable_Edited : Test
+{
+    PieceTable text{"hello world"};
+};
+
+TEST_F(PieceTable_Edited, InsertsInTheMiddle)
+{
+    text.insert(5, ",");
+
+    ASSERT_THAT(text.str(), StrEq("hello, world"));
+    ASSERT_THAT(text.length(), Eq(12));
+}
+
+TEST_F(PieceTable_Edited, ErasesAcrossPieces)
+{
+    text.insert(5, "XYZ");
+    text.erase(3, 6);
+
+    ASSERT_THAT(text.str(), StrEq("helworld"));
+}
+
+TEST_F(PieceTable_Edited, ErasingPastTheEndStopsAtTheEnd)
+{
+    text.erase(5, 100);
+
+    ASSERT_THAT(text.str(), StrEq("hello"));
+}
+
+TEST_F(PieceTable_Edited, EditsOutOfRangeThrow)
+{
+    ASSERT_THROW(text.insert(12, "!"), std::out_of_range);
+    ASSERT_THROW(text.erase(12, 1), std::out_of_range);
+}
+
+TEST_F(PieceTable_Edited, TypingAtTheSamePlaceExtendsOnePiece)
+{
+    for (char c : std::string{"abc"})
+        text.insert(text.length(), std::string(1, c));
+
+    ASSERT_THAT(text.str(), StrEq("hello worldabc"));
+    ASSERT_THAT(text.piece_count(), Eq(2));
+}
+
+TEST(PieceTable_RandomEdits, MatchesString)
+{
+    std::mt19937 rnd{46};
+    std::string expected = "The quick brown fox";
+    PieceTable text{expected};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const size_t pos = rnd() % (expected.size() + 1);
+        const size_t count = rnd() % 8;
+        const std::string inserted(rnd() % 5, static_cast<char>('a' + i % 26));
+
+        switch (rnd() % 3)
+        {
+        case 0:
+            expected.insert(pos, inserted);
+            text.insert(pos, inserted);
+            break;
+        case 1:
+            expected.erase(pos, count);
+            text.erase(pos, count);
+            break;
+        default:
+            expected.replace(pos, count, inserted);
+            text.replace(pos, count, inserted);
+        }
+
+        ASSERT_THAT(text.length(), Eq(expected.size()));
+    }
+
+    ASSERT_THAT(text.str(), StrEq(expected));
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(PieceTable_Benchmark, DISABLED_EditLatencyAgainstDocumentSize)
+{
+    constexpr int edits = 1000;
+
+    for (size_t megabytes : {1, 16, 256})
+    {
+        const std::string initial(megabytes << 20, 'x');
+        std::mt19937 rnd{46};
+
+        Document doc{initial};
+        std::string baseline = initial;
+
+        auto measure = [&](auto edit) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < edits; ++i)
+                edit(rnd() % initial.size());
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / edits;
+        };
+
+        const double document_us = measure([&](size_t pos) { doc.replace(pos, 3, "abcd"); });
+        const double string_us = measure([&](size_t pos) { baseline.replace(pos, 3, "abcd"); });
+
+        std::cout << megabytes << " MB: Document::replace " << document_us << " us, std::string::replace "
+                  << string_us << " us" << std::endl;
+    }
+}
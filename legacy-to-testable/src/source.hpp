@@ -10,25 +10,47 @@
 #include <iostream>
 #include <iterator>
 #include <list>
+#include <memory_resource>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct StatResult
 {
-    std::string description;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    std::pmr::string description;
     double value;
 
-    StatResult(const std::string& desc, double val)
-        : description(desc)
+    StatResult(std::string_view desc, double val, allocator_type alloc = {})
+        : description(desc, alloc)
         , value(val)
     {
     }
+
+    StatResult(const StatResult& other, allocator_type alloc = {})
+        : description(other.description, alloc)
+        , value(other.value)
+    {
+    }
+
+    StatResult(StatResult&& other) = default;
+
+    StatResult(StatResult&& other, allocator_type alloc)
+        : description(std::move(other.description), alloc)
+        , value(other.value)
+    {
+    }
+
+    StatResult& operator=(const StatResult&) = default;
+    StatResult& operator=(StatResult&&) = default;
 };
 
-using Data = std::vector<double>;
-using Results = std::vector<StatResult>;
+// pmr containers - a memory resource (e.g. per-batch arena) can back data & results
+using Data = std::pmr::vector<double>;
+using Results = std::pmr::vector<StatResult>;
 
 enum StatisticsType
 {
@@ -144,9 +166,9 @@ namespace Legacy
     {
         struct DataLoader
         {
-            Data load_data(const std::string& file_name) const
+            Data load_data(const std::string& file_name, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) const
             {
-                Data data;
+                Data data{memory_resource};
 
                 std::ifstream fin(file_name.c_str());
                 if (!fin)
@@ -168,12 +190,15 @@ namespace Legacy
             StatisticsType stat_type_;
             TDataLoader data_loader_;
             TLogger& logger_;
+            std::pmr::memory_resource* memory_resource_;
             Data data_;
             Results results_;
 
         public:
-            DataAnalyzer(StatisticsType stat_type, TDataLoader data_loader = TDataLoader{}, TLogger& logger = Logger::instance())
+            DataAnalyzer(StatisticsType stat_type, TDataLoader data_loader = TDataLoader{}, TLogger& logger = Logger::instance(),
+                std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource())
                 : stat_type_{stat_type}, data_loader_{data_loader}, logger_{logger}
+                , memory_resource_{memory_resource}, data_{memory_resource}, results_{memory_resource}
             {
             }
 
@@ -182,7 +207,11 @@ namespace Legacy
                 data_.clear();
                 results_.clear();
 
-                data_ = data_loader_.load_data(file_name);
+                // loaders that accept a memory resource allocate directly in it
+                if constexpr (requires { data_loader_.load_data(file_name, memory_resource_); })
+                    data_ = data_loader_.load_data(file_name, memory_resource_);
+                else
+                    data_ = data_loader_.load_data(file_name);
             
                 logger_.log("File " + file_name + " has been loaded...\n");
             }
@@ -199,22 +228,21 @@ namespace Legacy
                     double sum = std::accumulate(data_.begin(), data_.end(), 0.0);
                     double avg = sum / data_.size();
 
-                    StatResult result("Avg", avg);
-                    results_.push_back(result);
+                    results_.emplace_back("Avg", avg);
                 }
                 else if (stat_type_ == min_max)
                 {
                     double min = *(std::min_element(data_.begin(), data_.end()));
                     double max = *(std::max_element(data_.begin(), data_.end()));
 
-                    results_.push_back(StatResult("Min", min));
-                    results_.push_back(StatResult("Max", max));
+                    results_.emplace_back("Min", min);
+                    results_.emplace_back("Max", max);
                 }
                 else if (stat_type_ == sum)
                 {
                     double sum = std::accumulate(data_.begin(), data_.end(), 0.0);
 
-                    results_.push_back(StatResult("Sum", sum));
+                    results_.emplace_back("Sum", sum);
                 }
             }
 
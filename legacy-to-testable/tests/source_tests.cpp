@@ -2,6 +2,8 @@
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <memory_resource>
+#include <array>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -89,4 +91,25 @@ TEST(UnitTest_DataAnalyzer, ReadingFile)
 
     ASSERT_EQ(logger.messages.size(), 2);
     ASSERT_EQ(data_analyzer.calculated_results.size(), 1);
-}
\ No newline at end of file
+}
+
+TEST(UnitTest_DataAnalyzer, DataAndResultsAllocatedInMemoryResource)
+{
+    using namespace Legacy;
+
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    SpyLogger logger;
+
+    TestDataAnalyzer<StubDataLoader, SpyLogger> data_analyzer(StatisticsType::min_max, StubDataLoader{}, logger, &arena);
+    data_analyzer.load_data("data.dat");
+    data_analyzer.calculate();
+
+    const Results& results = data_analyzer.results();
+    ASSERT_EQ(results.size(), 2);
+    ASSERT_EQ(results.get_allocator().resource(), &arena);
+    ASSERT_EQ(results[0].description.get_allocator().resource(), &arena);
+    ASSERT_EQ(results[0].description, "Min");
+    ASSERT_EQ(results[1].value, 5);
+}
@@ -1,6 +1,400 @@
 #ifndef SNAKE_CONSOLE_TERMINAL_HPP
 #define SNAKE_CONSOLE_TERMINAL_HPP
 
-// TODO
+#include <snake/snake.hpp>
 
-#endif // SNAKE_CONSOLE_TERMINAL_HPP
\ No newline at end of file
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Text screen with front (what is displayed) & back (what is being drawn) buffers.
+// render_diff() produces ANSI escape sequences only for cells that changed since the last call.
+class ConsoleScreen
+{
+public:
+    enum class Style : uint8_t
+    {
+        Default,
+        Wall,
+        Snake,
+        Apple
+    };
+
+    struct Glyph
+    {
+        char ch{' '};
+        Style style{Style::Default};
+
+        bool operator==(const Glyph&) const = default;
+    };
+
+private:
+    int width_, height_;
+    std::vector<Glyph> front_;
+    std::vector<Glyph> back_;
+    std::string output_;
+
+public:
+    ConsoleScreen(int width, int height)
+        : width_{width}, height_{height}
+        , front_(static_cast<size_t>(width) * static_cast<size_t>(height))
+        , back_(front_.size())
+    {
+        output_.reserve(front_.size() * 8);
+    }
+
+    int width() const
+    {
+        return width_;
+    }
+
+    int height() const
+    {
+        return height_;
+    }
+
+    void clear()
+    {
+        std::ranges::fill(back_, Glyph{});
+    }
+
+    void put(int column, int row, Glyph glyph)
+    {
+        if (column >= 0 && column < width_ && row >= 0 && row < height_)
+            back_[static_cast<size_t>(row) * width_ + column] = glyph;
+    }
+
+    void put_text(int column, int row, std::string_view text)
+    {
+        for (char ch : text)
+            put(column++, row, Glyph{ch, Style::Default});
+    }
+
+    // escape sequences that turn the front buffer into the back buffer; front buffer is updated
+    std::string_view render_diff()
+    {
+        output_.clear();
+
+        int cursor_column = -1;
+        int cursor_row = -1;
+        std::optional<Style> current_style;
+
+        for (int row = 0; row < height_; ++row)
+        {
+            for (int column = 0; column < width_; ++column)
+            {
+                const size_t index = static_cast<size_t>(row) * width_ + column;
+                const Glyph& glyph = back_[index];
+
+                if (glyph == front_[index])
+                    continue;
+
+                if (row != cursor_row || column != cursor_column)
+                {
+                    output_ += "\x1b[";
+                    output_ += std::to_string(row + 1);
+                    output_ += ';';
+                    output_ += std::to_string(column + 1);
+                    output_ += 'H';
+                }
+
+                if (current_style != glyph.style)
+                {
+                    output_ += style_sequence(glyph.style);
+                    current_style = glyph.style;
+                }
+
+                output_ += glyph.ch;
+                front_[index] = glyph;
+
+                cursor_row = row;
+                cursor_column = column + 1;
+            }
+        }
+
+        if (current_style && current_style != Style::Default)
+            output_ += style_sequence(Style::Default);
+
+        return output_;
+    }
+
+private:
+    static std::string_view style_sequence(Style style)
+    {
+        switch (style)
+        {
+        case Style::Wall:
+            return "\x1b[0;100m";
+        case Style::Snake:
+            return "\x1b[0;42m";
+        case Style::Apple:
+            return "\x1b[0;91m";
+        default:
+            return "\x1b[0m";
+        }
+    }
+};
+
+// Terminal for ANSI consoles - each board cell takes two characters, every flush is a single write()
+class ConsoleTerminal
+{
+    int columns_, rows_;
+    int input_fd_, output_fd_;
+    ConsoleScreen screen_;
+    std::deque<Key> keys_;
+    std::string input_;
+    std::optional<termios> original_mode_;
+
+    // state used by the signal handler (static storage - zero initialized); restoring must be async-signal-safe
+    struct SignalRestore
+    {
+        int input_fd;
+        int output_fd;
+        termios mode;
+        bool has_mode;
+        char sequence[64];
+        size_t sequence_size;
+        struct sigaction previous_int;
+        struct sigaction previous_term;
+    };
+
+    static inline SignalRestore signal_restore_;
+
+public:
+    ConsoleTerminal(int columns, int rows, int input_fd = STDIN_FILENO, int output_fd = STDOUT_FILENO)
+        : columns_{columns}, rows_{rows}, input_fd_{input_fd}, output_fd_{output_fd}
+        , screen_{(columns + 1) * 2, rows + 1}
+    {
+        // VMIN = VTIME = 0 make reads return at once - the file status flags are left alone,
+        // since stdin & stdout of a tty usually share them and stdout must stay blocking
+        termios mode;
+        if (isatty(input_fd_) && tcgetattr(input_fd_, &mode) == 0)
+        {
+            original_mode_ = mode;
+            mode.c_lflag &= ~(ICANON | ECHO);
+            mode.c_cc[VMIN] = 0;
+            mode.c_cc[VTIME] = 0;
+            tcsetattr(input_fd_, TCSANOW, &mode);
+        }
+
+        install_signal_handlers();
+
+        write_all("\x1b[?25l\x1b[2J");
+    }
+
+    ConsoleTerminal(const ConsoleTerminal&) = delete;
+    ConsoleTerminal& operator=(const ConsoleTerminal&) = delete;
+
+    ~ConsoleTerminal()
+    {
+        write_all(restore_sequence());
+
+        if (original_mode_)
+            tcsetattr(input_fd_, TCSANOW, &*original_mode_);
+
+        sigaction(SIGINT, &signal_restore_.previous_int, nullptr);
+        sigaction(SIGTERM, &signal_restore_.previous_term, nullptr);
+    }
+
+    // one key per call - keys typed between ticks are queued
+    std::optional<Key> read_key()
+    {
+        // poll keeps reads of non-tty input (e.g. a pipe) from blocking
+        pollfd input{input_fd_, POLLIN, 0};
+        char buffer[64];
+        ssize_t count;
+        while (poll(&input, 1, 0) > 0 && (input.revents & POLLIN)
+            && (count = ::read(input_fd_, buffer, sizeof(buffer))) > 0)
+            input_.append(buffer, static_cast<size_t>(count));
+
+        parse_input();
+
+        if (keys_.empty())
+            return std::nullopt;
+
+        Key key = keys_.front();
+        keys_.pop_front();
+        return key;
+    }
+
+    void clear()
+    {
+        screen_.clear();
+    }
+
+    void render_board(const Board& board)
+    {
+        for (int i = 0; i <= columns_; ++i)
+        {
+            put_cell(i, 0, ConsoleScreen::Style::Wall);
+            put_cell(i, rows_, ConsoleScreen::Style::Wall);
+        }
+
+        for (int i = 0; i <= rows_; ++i)
+        {
+            put_cell(0, i, ConsoleScreen::Style::Wall);
+            put_cell(columns_, i, ConsoleScreen::Style::Wall);
+        }
+
+        for (const auto& apple : board.apples())
+        {
+            screen_.put(apple.x * 2, apple.y, {'(', ConsoleScreen::Style::Apple});
+            screen_.put(apple.x * 2 + 1, apple.y, {')', ConsoleScreen::Style::Apple});
+        }
+    }
+
+    template <typename TSnake>
+    void render_snake(const TSnake& snake)
+    {
+        for (const auto& segment : snake.segments())
+            put_cell(segment.x, segment.y, ConsoleScreen::Style::Snake);
+    }
+
+    void render_text(const std::vector<std::string>& lines)
+    {
+        screen_.clear();
+
+        int row = screen_.height() / 3;
+        for (const auto& line : lines)
+        {
+            const int column = std::max(0, (screen_.width() - static_cast<int>(line.size())) / 2);
+            screen_.put_text(column, row++, line);
+        }
+    }
+
+    void flush()
+    {
+        write_all(screen_.render_diff());
+    }
+
+private:
+    void put_cell(int x, int y, ConsoleScreen::Style style)
+    {
+        screen_.put(x * 2, y, {' ', style});
+        screen_.put(x * 2 + 1, y, {' ', style});
+    }
+
+    void parse_input()
+    {
+        size_t pos = 0;
+        while (pos < input_.size())
+        {
+            const char ch = input_[pos];
+
+            if (ch == '\x1b')
+            {
+                if (pos + 2 >= input_.size())
+                    break; // incomplete escape sequence - wait for the rest
+
+                if (input_[pos + 1] == '[')
+                {
+                    switch (input_[pos + 2])
+                    {
+                    case 'A':
+                        keys_.push_back(Key::ArrowUp);
+                        break;
+                    case 'B':
+                        keys_.push_back(Key::ArrowDown);
+                        break;
+                    case 'C':
+                        keys_.push_back(Key::ArrowRight);
+                        break;
+                    case 'D':
+                        keys_.push_back(Key::ArrowLeft);
+                        break;
+                    }
+                    pos += 3;
+                    continue;
+                }
+            }
+            else if (ch == 'p' || ch == 'P')
+            {
+                keys_.push_back(Key::P);
+            }
+            else if (ch == 'q' || ch == 'Q')
+            {
+                keys_.push_back(Key::Q);
+            }
+
+            ++pos;
+        }
+
+        input_.erase(0, pos);
+    }
+
+    // partial frames are never dropped - the front buffer already assumes the whole frame is displayed
+    void write_all(std::string_view data)
+    {
+        write_all(output_fd_, data.data(), data.size());
+    }
+
+    static void write_all(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t written = ::write(fd, data, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                pollfd output{fd, POLLOUT, 0};
+                if (errno == EAGAIN && poll(&output, 1, -1) >= 0)
+                    continue;
+
+                return;
+            }
+
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    std::string restore_sequence() const
+    {
+        return "\x1b[0m\x1b[" + std::to_string(screen_.height() + 1) + ";1H\x1b[?25h";
+    }
+
+    void install_signal_handlers()
+    {
+        const std::string sequence = restore_sequence();
+
+        signal_restore_.input_fd = input_fd_;
+        signal_restore_.output_fd = output_fd_;
+        signal_restore_.has_mode = original_mode_.has_value();
+        if (original_mode_)
+            signal_restore_.mode = *original_mode_;
+        signal_restore_.sequence_size = std::min(sequence.size(), sizeof(signal_restore_.sequence));
+        std::copy_n(sequence.begin(), signal_restore_.sequence_size, signal_restore_.sequence);
+
+        struct sigaction action{};
+        action.sa_handler = on_signal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, &signal_restore_.previous_int);
+        sigaction(SIGTERM, &action, &signal_restore_.previous_term);
+    }
+
+    // console is restored & the signal is raised again with its default action
+    static void on_signal(int signal)
+    {
+        const SignalRestore& restore = signal_restore_;
+        write_all(restore.output_fd, restore.sequence, restore.sequence_size);
+        if (restore.has_mode)
+            tcsetattr(restore.input_fd, TCSANOW, &restore.mode);
+
+        ::signal(signal, SIG_DFL);
+        raise(signal);
+    }
+};
+
+#endif // SNAKE_CONSOLE_TERMINAL_HPP
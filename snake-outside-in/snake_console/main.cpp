@@ -1,9 +1,36 @@
 #include <iostream>
+#include <optional>
+#include <string_view>
 #include <snake/snake.hpp>
+#include <snake/frame_scheduler.hpp>
+#include <snake/frame_timing.hpp>
+#include <snake/spectator_feed.hpp>
 #include "console_terminal.hpp"
 
 using namespace std;
 
-int main()
+int main(int argc, char* argv[])
 {
-}
\ No newline at end of file
+    constexpr int rows = 20;
+    constexpr int columns = 40;
+
+    Board board(columns, rows, 5);
+    Snake snake(board);
+    ConsoleTerminal terminal(columns, rows);
+    SnakeGame<ConsoleTerminal, Snake> game(terminal, snake, board);
+
+    // --spectate: every tick is published to shared memory "/snake" for SpectatorReader
+    std::optional<SpectatorPublisher> spectator_feed;
+    if (argc > 1 && argv[1] == std::string_view{"--spectate"})
+    {
+        spectator_feed.emplace("/snake");
+        game.on_tick([&](const Board& board, const Snake& snake) { spectator_feed->publish(board, snake); });
+    }
+
+    using namespace std::chrono_literals;
+    FixedTimestepScheduler scheduler{100ms, 33ms};
+    game.run(scheduler);
+
+    if constexpr (frame_timing_enabled)
+        frame_timings().dump(std::cout);
+}
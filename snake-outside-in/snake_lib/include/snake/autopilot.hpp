@@ -0,0 +1,518 @@
+#ifndef SNAKE_AUTOPILOT_HPP
+#define SNAKE_AUTOPILOT_HPP
+
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Deterministic player: follows a BFS distance field to the nearest apple, kept safe by a Hamiltonian cycle.
+// The field ignores the snake's body (obstacles are checked when a move is chosen), so moving body costs
+// nothing and a decision is a lookup of three neighbours. When apples change the field is patched locally:
+// a new apple lowers distances around it, an eaten one re-seeds only the cells that were closest to it.
+// Moves off the cycle are taken only as forward shortcuts that neither overtake the tail nor skip
+// the next apple, so the body stays in cycle order and every move makes progress. A snake facing against
+// the cycle (e.g. at the start) rejoins it at the nearest cell ahead.
+class Autopilot
+{
+    static constexpr uint32_t unreachable = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t shortcut_margin = 3;
+    static constexpr std::array<Direction, 4> directions_{Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+
+    const Board& board_;
+    const Snake& snake_;
+    size_t stride_;
+    std::vector<uint32_t> distances_;
+    std::vector<uint32_t> bfs_queue_;
+    std::vector<uint32_t> affected_;
+    std::vector<uint32_t> affected_mark_;
+    uint32_t affected_stamp_{0};
+    std::vector<std::optional<Direction>> cycle_; // Hamiltonian cycle successor of each inner cell
+    std::vector<uint32_t> cycle_order_;           // position of each inner cell along the cycle
+    uint32_t cycle_length_{0};
+    std::optional<size_t> detour_;               // inner cell left out of the cycle (odd number of rows & columns)
+    size_t detour_entry_{0};                      // cycle cell the detour is entered from
+    std::vector<uint64_t> apples_on_cycle_;       // bit per cycle position occupied by an apple
+    std::optional<uint64_t> apples_revision_;
+    size_t apples_count_{0};
+
+public:
+    Autopilot(const Board& board, const Snake& snake)
+        : board_{board}, snake_{snake}
+        , stride_{static_cast<size_t>(board.width()) + 1}
+        , distances_(stride_ * (static_cast<size_t>(board.height()) + 1), unreachable)
+        , affected_mark_(distances_.size())
+        , cycle_(distances_.size())
+        , cycle_order_(distances_.size())
+    {
+        bfs_queue_.reserve(distances_.size());
+        affected_.reserve(distances_.size());
+        build_hamiltonian_cycle();
+        apples_on_cycle_.resize((cycle_length_ + 63) / 64);
+    }
+
+    Direction next_direction()
+    {
+        if (apples_revision_ != board_.apples_revision())
+            update_apples();
+
+        const Point head = snake_.head();
+        const Direction current = snake_.direction();
+        const auto along_cycle = cycle_[index_of(head)];
+
+        if (!along_cycle)
+            return greedy_direction(head, current);
+
+        const uint32_t head_order = cycle_order_[index_of(head)];
+        const uint32_t to_apple = cycle_distance_to_apple(head_order);
+        const uint32_t free_ahead = cycle_[index_of(snake_.tail())] ? cycle_distance(head_order, cycle_order_[index_of(snake_.tail())]) : 0;
+        const bool shortcuts_allowed = snake_.segments().size() * 2 <= cycle_length_;
+        const size_t room_needed = shortcut_margin + snake_.segments().size() + board_.apples().size();
+
+        std::optional<Direction> best;
+        uint32_t best_distance = unreachable;
+        uint32_t best_jump = 0;
+        std::optional<Direction> rejoin; // nearest cell ahead along the cycle - when the snake faces against it
+        uint32_t rejoin_jump = unreachable;
+
+        for (auto direction : directions_)
+        {
+            const Point next = step(head, direction);
+            if (direction == opposite(current) || is_blocked(next) || !cycle_[index_of(next)])
+                continue;
+
+            const uint32_t jump = cycle_distance(head_order, cycle_order_[index_of(next)]);
+            if (jump > 0 && jump < rejoin_jump)
+            {
+                rejoin = direction;
+                rejoin_jump = jump;
+            }
+
+            // shortcut must not jump over the nearest apple along the cycle & must leave room ahead for the body
+            // and every apple on the board - the snake may eat them all before its tail passes the skipped cells.
+            // The detour cell takes the place of the cell it bypasses, so entering it is a step along the cycle.
+            const bool is_allowed = direction == *along_cycle || jump == 1
+                || (shortcuts_allowed && jump > 0 && jump <= to_apple && jump + room_needed < free_ahead);
+
+            if (!is_allowed)
+                continue;
+
+            const uint32_t distance = distances_[index_of(next)];
+            if (!best || distance < best_distance || (distance == best_distance && jump > best_jump))
+            {
+                best = direction;
+                best_distance = distance;
+                best_jump = jump;
+            }
+        }
+
+        return best ? *best : rejoin ? *rejoin : greedy_direction(head, current);
+    }
+
+    const Snake& snake() const
+    {
+        return snake_;
+    }
+
+    std::optional<Direction> cycle_direction(const Point& pt) const
+    {
+        return cycle_[index_of(pt)];
+    }
+
+    uint32_t distance_to_apple(const Point& pt) const
+    {
+        return distances_[index_of(pt)];
+    }
+
+private:
+    // nearest free cell towards an apple - used when the head is off the cycle
+    Direction greedy_direction(const Point& head, Direction current) const
+    {
+        std::optional<Direction> best;
+        uint32_t best_distance = unreachable;
+
+        for (auto direction : directions_)
+        {
+            const Point next = step(head, direction);
+            if (direction == opposite(current) || is_blocked(next))
+                continue;
+
+            if (!best || distances_[index_of(next)] < best_distance)
+            {
+                best = direction;
+                best_distance = distances_[index_of(next)];
+            }
+        }
+
+        return best.value_or(current);
+    }
+
+    uint32_t cycle_distance_to_apple(uint32_t from) const
+    {
+        const size_t words = apples_on_cycle_.size();
+        const uint32_t start = from + 1 == cycle_length_ ? 0 : from + 1;
+
+        // scan bits from `start` to the end of the cycle and wrap around
+        for (size_t i = 0; i <= words; ++i)
+        {
+            const size_t word_index = (start / 64 + i) % words;
+            uint64_t word = apples_on_cycle_[word_index];
+            if (i == 0)
+                word &= ~uint64_t{0} << (start % 64);
+            else if (i == words)
+                word &= (uint64_t{1} << (start % 64)) - 1;
+
+            if (word)
+                return cycle_distance(from, static_cast<uint32_t>(word_index * 64 + std::countr_zero(word)));
+        }
+
+        return cycle_length_;
+    }
+
+    uint32_t cycle_distance(uint32_t from, uint32_t to) const
+    {
+        return to >= from ? to - from : to + cycle_length_ - from;
+    }
+
+    bool is_wall(const Point& pt) const
+    {
+        return board_.is_hitting_walls(pt);
+    }
+
+    bool is_blocked(const Point& pt) const
+    {
+        return is_wall(pt) || board_.has_snake_segment(pt);
+    }
+
+    size_t index_of(const Point& pt) const
+    {
+        return static_cast<size_t>(pt.y) * stride_ + static_cast<size_t>(pt.x);
+    }
+
+    Point point_of(size_t index) const
+    {
+        return Point{static_cast<int>(index % stride_), static_cast<int>(index / stride_)};
+    }
+
+    // Apples are appended by Board::add_apple() & eaten only by the snake's head, so the change since
+    // the last decision is: at most one apple gone from the head's cell & new apples at the end of the list.
+    // Anything else (e.g. the very first call) rebuilds the field from scratch.
+    void update_apples()
+    {
+        const auto& apples = board_.apples();
+        const uint64_t changes = apples_revision_ ? board_.apples_revision() - *apples_revision_ : 0;
+        const uint64_t added_twice = changes + apples.size() - apples_count_;
+        const uint64_t added = added_twice / 2;
+        const uint64_t removed = changes - added;
+
+        if (!apples_revision_ || added_twice % 2 != 0 || removed > 1 || added > apples.size()
+            || (removed == 1 && distances_[index_of(snake_.head())] != 0))
+        {
+            rebuild_distances();
+        }
+        else
+        {
+            if (removed == 1 && !board_.has_apple(snake_.head()))
+                remove_source(snake_.head());
+
+            for (size_t i = apples.size() - added; i < apples.size(); ++i)
+                add_source(apples[i]);
+        }
+
+        apples_revision_ = board_.apples_revision();
+        apples_count_ = apples.size();
+    }
+
+    // multi-source BFS from all apples
+    void rebuild_distances()
+    {
+        std::ranges::fill(distances_, unreachable);
+        std::ranges::fill(apples_on_cycle_, 0);
+        bfs_queue_.clear();
+
+        for (const auto& apple : board_.apples())
+        {
+            if (is_wall(apple) || distances_[index_of(apple)] == 0)
+                continue;
+
+            distances_[index_of(apple)] = 0;
+            mark_apple_on_cycle(apple, true);
+            bfs_queue_.push_back(static_cast<uint32_t>(index_of(apple)));
+        }
+
+        relax_queued();
+    }
+
+    void add_source(const Point& apple)
+    {
+        if (is_wall(apple) || distances_[index_of(apple)] == 0)
+            return;
+
+        distances_[index_of(apple)] = 0;
+        mark_apple_on_cycle(apple, true);
+
+        bfs_queue_.clear();
+        bfs_queue_.push_back(static_cast<uint32_t>(index_of(apple)));
+        relax_queued();
+    }
+
+    void remove_source(const Point& apple)
+    {
+        mark_apple_on_cycle(apple, false);
+
+        // cells whose shortest path may lead through the removed apple - reachable by steps that increase distance
+        ++affected_stamp_;
+        affected_.clear();
+        affected_.push_back(static_cast<uint32_t>(index_of(apple)));
+        affected_mark_[affected_.back()] = affected_stamp_;
+
+        for (size_t i = 0; i < affected_.size(); ++i)
+        {
+            const Point pt = point_of(affected_[i]);
+            const uint32_t distance = distances_[affected_[i]] + 1;
+
+            for (auto direction : directions_)
+            {
+                const size_t next = index_of(step(pt, direction));
+                if (is_wall(point_of(next)) || affected_mark_[next] == affected_stamp_ || distances_[next] != distance)
+                    continue;
+
+                affected_mark_[next] = affected_stamp_;
+                affected_.push_back(static_cast<uint32_t>(next));
+            }
+        }
+
+        for (auto cell : affected_)
+            distances_[cell] = unreachable;
+
+        // re-seed them from the unaffected border & let distances flow inwards
+        bfs_queue_.clear();
+        for (auto cell : affected_)
+        {
+            const Point pt = point_of(cell);
+            for (auto direction : directions_)
+            {
+                const size_t next = index_of(step(pt, direction));
+                if (!is_wall(point_of(next)) && distances_[next] != unreachable && distances_[next] + 1 < distances_[cell])
+                    distances_[cell] = distances_[next] + 1;
+            }
+
+            if (distances_[cell] != unreachable)
+                bfs_queue_.push_back(cell);
+        }
+
+        relax_queued();
+    }
+
+    // propagates distances of queued cells to neighbours while it shortens them
+    void relax_queued()
+    {
+        for (size_t i = 0; i < bfs_queue_.size(); ++i)
+        {
+            const Point pt = point_of(bfs_queue_[i]);
+            const uint32_t distance = distances_[bfs_queue_[i]] + 1;
+
+            for (auto direction : directions_)
+            {
+                const Point next = step(pt, direction);
+                if (is_wall(next) || distances_[index_of(next)] <= distance)
+                    continue;
+
+                distances_[index_of(next)] = distance;
+                bfs_queue_.push_back(static_cast<uint32_t>(index_of(next)));
+            }
+        }
+    }
+
+    void mark_apple_on_cycle(const Point& apple, bool is_present)
+    {
+        if (!cycle_[index_of(apple)])
+            return;
+
+        // apple on the detour is marked at its entry, so shortcuts stop there; the bit is shared by both cells
+        const bool is_shared = detour_ && (index_of(apple) == *detour_ || index_of(apple) == detour_entry_);
+        if (!is_present && is_shared && board_.has_apple(point_of(index_of(apple) == *detour_ ? detour_entry_ : *detour_)))
+            return;
+
+        const uint32_t order = cycle_order_[index_of(apple) == detour_ ? detour_entry_ : index_of(apple)];
+        if (is_present)
+            apples_on_cycle_[order / 64] |= uint64_t{1} << (order % 64);
+        else
+            apples_on_cycle_[order / 64] &= ~(uint64_t{1} << (order % 64));
+    }
+
+    // zig-zag through inner cells & return along the first column (or row). With odd number of both rows
+    // and columns the last two rows are covered column by column and corner (1, height - 1) is left out -
+    // it is a detour from (2, height - 1) to (1, height - 2) that bypasses (2, height - 2).
+    void build_hamiltonian_cycle()
+    {
+        const int inner_width = board_.width() - 1;
+        const int inner_height = board_.height() - 1;
+
+        if (inner_width < 2 || inner_height < 2)
+            return;
+
+        std::vector<Point> path;
+        path.reserve(distances_.size());
+
+        const bool odd_rows = inner_height % 2 == 1;
+
+        if (!odd_rows || inner_width % 2 == 1)
+        {
+            const int zig_zag_rows = odd_rows ? inner_height - 2 : inner_height;
+
+            for (int y = 1; y <= zig_zag_rows; ++y)
+                for (int i = 2; i <= inner_width; ++i)
+                    path.push_back({y % 2 == 1 ? i : inner_width + 2 - i, y});
+
+            if (odd_rows)
+            {
+                for (int x = inner_width; x >= 2; --x)
+                {
+                    const bool downwards = (inner_width - x) % 2 == 0;
+                    path.push_back({x, downwards ? inner_height - 1 : inner_height});
+                    path.push_back({x, downwards ? inner_height : inner_height - 1});
+                }
+            }
+
+            for (int y = odd_rows ? inner_height - 1 : inner_height; y >= 1; --y)
+                path.push_back({1, y});
+        }
+        else
+        {
+            for (int x = 1; x <= inner_width; ++x)
+                for (int i = 2; i <= inner_height; ++i)
+                    path.push_back({x, x % 2 == 1 ? i : inner_height + 2 - i});
+
+            for (int x = inner_width; x >= 1; --x)
+                path.push_back({x, 1});
+        }
+
+        cycle_length_ = static_cast<uint32_t>(path.size());
+        for (size_t i = 0; i < path.size(); ++i)
+        {
+            const Point& from = path[i];
+            const Point& to = path[(i + 1) % path.size()];
+
+            cycle_order_[index_of(from)] = static_cast<uint32_t>(i);
+            cycle_[index_of(from)] = to.x > from.x ? Direction::Right
+                : to.x < from.x ? Direction::Left
+                : to.y > from.y ? Direction::Down
+                : Direction::Up;
+        }
+
+        if (odd_rows && inner_width % 2 == 1)
+        {
+            detour_ = index_of({1, inner_height});
+            detour_entry_ = index_of({2, inner_height});
+            cycle_[*detour_] = Direction::Up;
+            cycle_order_[*detour_] = cycle_order_[index_of({2, inner_height - 1})];
+        }
+    }
+
+    static Point step(const Point& pt, Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::Up:
+            return {pt.x, pt.y - 1};
+        case Direction::Down:
+            return {pt.x, pt.y + 1};
+        case Direction::Left:
+            return {pt.x - 1, pt.y};
+        default:
+            return {pt.x + 1, pt.y};
+        }
+    }
+
+    static Direction opposite(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::Up:
+            return Direction::Down;
+        case Direction::Down:
+            return Direction::Up;
+        case Direction::Left:
+            return Direction::Right;
+        default:
+            return Direction::Left;
+        }
+    }
+};
+
+// Key source driven by autopilot - starts the game and steers the snake.
+// Quits when the snake dies, after max_ticks or when Q is read from the wrapped terminal.
+template <typename TTerminal>
+class AutopilotTerminal
+{
+    TTerminal& terminal_;
+    Autopilot& autopilot_;
+    size_t max_ticks_;
+    size_t ticks_{0};
+
+public:
+    AutopilotTerminal(TTerminal& terminal, Autopilot& autopilot, size_t max_ticks = std::numeric_limits<size_t>::max())
+        : terminal_{terminal}, autopilot_{autopilot}, max_ticks_{max_ticks}
+    {}
+
+    size_t ticks() const
+    {
+        return ticks_;
+    }
+
+    std::optional<Key> read_key()
+    {
+        if (terminal_.read_key() == Key::Q || !autopilot_.snake().is_alive() || ticks_ == max_ticks_)
+            return Key::Q;
+
+        if (ticks_++ == 0)
+            return Key::P;
+
+        switch (autopilot_.next_direction())
+        {
+        case Direction::Up:
+            return Key::ArrowUp;
+        case Direction::Down:
+            return Key::ArrowDown;
+        case Direction::Left:
+            return Key::ArrowLeft;
+        default:
+            return Key::ArrowRight;
+        }
+    }
+
+    void clear()
+    {
+        terminal_.clear();
+    }
+
+    void render_board(const Board& board)
+    {
+        terminal_.render_board(board);
+    }
+
+    template <typename TSnake>
+    void render_snake(const TSnake& snake)
+    {
+        terminal_.render_snake(snake);
+    }
+
+    void render_text(const std::vector<std::string>& lines)
+    {
+        terminal_.render_text(lines);
+    }
+
+    void flush()
+    {
+        terminal_.flush();
+    }
+};
+
+#endif // SNAKE_AUTOPILOT_HPP
@@ -0,0 +1,321 @@
+#ifndef SNAKE_BATCH_SIMULATION_HPP
+#define SNAKE_BATCH_SIMULATION_HPP
+
+#include "snake/chunked_workers.hpp"
+#include "snake/random.hpp"
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct BatchObservations
+{
+    std::span<const int32_t> head_x;
+    std::span<const int32_t> head_y;
+    std::span<const int32_t> apple_x;
+    std::span<const int32_t> apple_y;
+    std::span<const uint32_t> length;
+    std::span<const Direction> direction;
+};
+
+struct BatchStepResult
+{
+    BatchObservations observations;
+    std::span<const float> rewards; // +1 apple eaten, -1 snake died, 0 otherwise
+    std::span<const uint8_t> dones; // episode finished - environment has been reset
+};
+
+// Headless simulation of many independent boards (one snake & one apple each) stepped in lock-step.
+// Rules match Board & Snake: walls at x == 0, x == width, y == 0, y == height.
+// State is kept as structure-of-arrays; environments are split into contiguous chunks - one chunk per thread.
+class BatchSimulation
+{
+    static constexpr uint32_t no_apple = UINT32_MAX;
+
+    int width_, height_;
+    size_t env_count_;
+    size_t stride_;         // cells in a row (walls included)
+    size_t body_capacity_;  // max snake length - all inner cells
+    size_t words_per_env_;  // occupancy bitset words of single env
+
+    // per environment state
+    std::vector<Direction> direction_;
+    std::vector<int32_t> head_x_, head_y_;
+    std::vector<int32_t> apple_x_, apple_y_;
+    std::vector<uint32_t> apple_cell_;
+    std::vector<uint32_t> length_;
+    std::vector<uint32_t> body_head_;  // index of the head in the body ring
+    std::vector<uint32_t> body_;       // env_count * body_capacity cells (ring per env)
+    std::vector<uint64_t> occupied_;   // env_count * words_per_env bits
+    std::vector<Xoshiro256StarStar> rnd_engines_;
+
+    std::vector<float> rewards_;
+    std::vector<uint8_t> dones_;
+
+    ChunkedWorkers workers_;
+
+public:
+    BatchSimulation(size_t env_count, int width = 20, int height = 10, uint64_t seed = 0,
+        size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        : width_{validated_width(width, height)}, height_{height}, env_count_{env_count}
+        , stride_{static_cast<size_t>(width) + 1}
+        , body_capacity_{static_cast<size_t>(width - 1) * static_cast<size_t>(height - 1)}
+        , words_per_env_{(stride_ * (static_cast<size_t>(height) + 1) + 63) / 64}
+        , direction_(env_count), head_x_(env_count), head_y_(env_count)
+        , apple_x_(env_count), apple_y_(env_count), apple_cell_(env_count)
+        , length_(env_count), body_head_(env_count)
+        , body_(env_count * body_capacity_), occupied_(env_count * words_per_env_)
+        , rewards_(env_count), dones_(env_count)
+        , workers_{std::clamp<size_t>(thread_count, 1, std::max<size_t>(env_count, 1))}
+    {
+        rnd_engines_.reserve(env_count);
+        for (size_t env = 0; env < env_count; ++env)
+        {
+            rnd_engines_.emplace_back(seed + env);
+            reset(env);
+        }
+    }
+
+    BatchSimulation(const BatchSimulation&) = delete;
+    BatchSimulation& operator=(const BatchSimulation&) = delete;
+
+    size_t env_count() const
+    {
+        return env_count_;
+    }
+
+    int width() const
+    {
+        return width_;
+    }
+
+    int height() const
+    {
+        return height_;
+    }
+
+    BatchStepResult step(std::span<const Direction> actions)
+    {
+        if (actions.size() != env_count_)
+            throw std::invalid_argument("One action per environment is required");
+
+        auto step_range = [this, actions](size_t first, size_t last) {
+            for (size_t env = first; env < last; ++env)
+                step_env(env, actions[env]);
+        };
+        workers_.run(env_count_, step_range);
+
+        return {observations(), rewards_, dones_};
+    }
+
+    BatchObservations observations() const
+    {
+        return {head_x_, head_y_, apple_x_, apple_y_, length_, direction_};
+    }
+
+    bool has_snake_segment(size_t env, const Point& pt) const
+    {
+        if (pt.x < 0 || pt.x > width_ || pt.y < 0 || pt.y > height_)
+            return false;
+
+        return is_occupied(env, cell_of(pt.x, pt.y));
+    }
+
+    void reset(size_t env)
+    {
+        std::fill_n(occupied_.begin() + static_cast<std::ptrdiff_t>(env * words_per_env_), words_per_env_, 0);
+
+        const int32_t x = width_ / 2;
+        const int32_t y = height_ / 2;
+
+        direction_[env] = Direction::Up;
+        head_x_[env] = x;
+        head_y_[env] = y;
+        length_[env] = 2;
+        body_head_[env] = 0;
+
+        uint32_t* body = body_of(env);
+        body[0] = cell_of(x, y);
+        body[1] = cell_of(x, y + 1);
+        set_occupied(env, body[0]);
+        set_occupied(env, body[1]);
+
+        spawn_apple(env);
+    }
+
+private:
+    // called from the first member initializer - bad sizes throw before any array is allocated
+    static int validated_width(int width, int height)
+    {
+        if (width < 4 || height < 4)
+            throw std::invalid_argument("Board is too small");
+
+        if ((static_cast<uint64_t>(width) + 1) * (static_cast<uint64_t>(height) + 1) > UINT32_MAX)
+            throw std::invalid_argument("Board is too large");
+
+        return width;
+    }
+
+    void step_env(size_t env, Direction action)
+    {
+        rewards_[env] = 0.0f;
+        dones_[env] = 0;
+
+        if (action != opposite(direction_[env]))
+            direction_[env] = action;
+
+        int32_t x = head_x_[env];
+        int32_t y = head_y_[env];
+
+        switch (direction_[env])
+        {
+        case Direction::Up:
+            --y;
+            break;
+        case Direction::Down:
+            ++y;
+            break;
+        case Direction::Left:
+            --x;
+            break;
+        case Direction::Right:
+            ++x;
+            break;
+        }
+
+        if (x <= 0 || x >= width_ || y <= 0 || y >= height_ || is_occupied(env, cell_of(x, y)))
+        {
+            finish_episode(env, -1.0f);
+            return;
+        }
+
+        const uint32_t new_head = cell_of(x, y);
+        head_x_[env] = x;
+        head_y_[env] = y;
+
+        uint32_t* body = body_of(env);
+        body_head_[env] = body_head_[env] == 0 ? static_cast<uint32_t>(body_capacity_ - 1) : body_head_[env] - 1;
+        body[body_head_[env]] = new_head;
+        set_occupied(env, new_head);
+
+        if (new_head == apple_cell_[env])
+        {
+            rewards_[env] = 1.0f;
+            ++length_[env];
+
+            if (length_[env] == body_capacity_) // whole board is filled
+            {
+                finish_episode(env, 1.0f);
+                return;
+            }
+
+            spawn_apple(env);
+        }
+        else
+        {
+            size_t tail = body_head_[env] + length_[env];
+            if (tail >= body_capacity_)
+                tail -= body_capacity_;
+
+            clear_occupied(env, body[tail]);
+        }
+    }
+
+    void finish_episode(size_t env, float reward)
+    {
+        rewards_[env] = reward;
+        dones_[env] = 1;
+        reset(env);
+    }
+
+    void spawn_apple(size_t env)
+    {
+        auto& rnd = rnd_engines_[env];
+        const auto inner_width = static_cast<uint32_t>(width_ - 1);
+        const auto inner_height = static_cast<uint32_t>(height_ - 1);
+
+        // rejection sampling is fast while the board is mostly empty...
+        for (int attempt = 0; attempt < 32; ++attempt)
+        {
+            const auto x = static_cast<int32_t>(1 + rnd.bounded(inner_width));
+            const auto y = static_cast<int32_t>(1 + rnd.bounded(inner_height));
+
+            if (!is_occupied(env, cell_of(x, y)))
+            {
+                place_apple(env, x, y);
+                return;
+            }
+        }
+
+        // ...otherwise pick uniformly among free cells
+        const auto free_cells = static_cast<uint32_t>(body_capacity_ - length_[env]);
+        if (free_cells == 0)
+        {
+            apple_cell_[env] = no_apple;
+            apple_x_[env] = apple_y_[env] = -1;
+            return;
+        }
+
+        uint32_t nth = rnd.bounded(free_cells);
+        for (int32_t y = 1; y < height_; ++y)
+            for (int32_t x = 1; x < width_; ++x)
+                if (!is_occupied(env, cell_of(x, y)) && nth-- == 0)
+                {
+                    place_apple(env, x, y);
+                    return;
+                }
+    }
+
+    void place_apple(size_t env, int32_t x, int32_t y)
+    {
+        apple_x_[env] = x;
+        apple_y_[env] = y;
+        apple_cell_[env] = cell_of(x, y);
+    }
+
+    uint32_t cell_of(int32_t x, int32_t y) const
+    {
+        return static_cast<uint32_t>(static_cast<size_t>(y) * stride_ + static_cast<size_t>(x));
+    }
+
+    uint32_t* body_of(size_t env)
+    {
+        return body_.data() + env * body_capacity_;
+    }
+
+    bool is_occupied(size_t env, uint32_t cell) const
+    {
+        return (occupied_[env * words_per_env_ + cell / 64] >> (cell % 64)) & 1u;
+    }
+
+    void set_occupied(size_t env, uint32_t cell)
+    {
+        occupied_[env * words_per_env_ + cell / 64] |= uint64_t{1} << (cell % 64);
+    }
+
+    void clear_occupied(size_t env, uint32_t cell)
+    {
+        occupied_[env * words_per_env_ + cell / 64] &= ~(uint64_t{1} << (cell % 64));
+    }
+
+    static Direction opposite(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::Up:
+            return Direction::Down;
+        case Direction::Down:
+            return Direction::Up;
+        case Direction::Left:
+            return Direction::Right;
+        default:
+            return Direction::Left;
+        }
+    }
+};
+
+#endif // SNAKE_BATCH_SIMULATION_HPP
@@ -0,0 +1,96 @@
+#ifndef SNAKE_CHUNKED_WORKERS_HPP
+#define SNAKE_CHUNKED_WORKERS_HPP
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Persistent threads running the same job over [0, count) split into contiguous chunks - one chunk per thread.
+// The calling thread takes the first chunk; run() returns when all chunks are done.
+class ChunkedWorkers
+{
+    size_t workers_count_;
+    size_t count_{0};
+    void* job_{nullptr};
+    void (*invoke_)(void*, size_t, size_t){nullptr};
+    bool stopping_{false};
+    std::barrier<> started_;
+    std::barrier<> finished_;
+    std::vector<std::jthread> workers_;
+
+public:
+    explicit ChunkedWorkers(size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        : workers_count_{std::max<size_t>(thread_count, 1)}
+        , started_{static_cast<std::ptrdiff_t>(workers_count_)}
+        , finished_{static_cast<std::ptrdiff_t>(workers_count_)}
+    {
+        for (size_t worker = 1; worker < workers_count_; ++worker)
+        {
+            workers_.emplace_back([this, worker] { run_worker(worker); });
+        }
+    }
+
+    ChunkedWorkers(const ChunkedWorkers&) = delete;
+    ChunkedWorkers& operator=(const ChunkedWorkers&) = delete;
+
+    ~ChunkedWorkers()
+    {
+        stopping_ = true;
+        if (!workers_.empty())
+            started_.arrive_and_wait();
+    }
+
+    size_t thread_count() const
+    {
+        return workers_count_;
+    }
+
+    // job(first, last) is called once per chunk
+    template <typename TJob>
+    void run(size_t count, TJob& job)
+    {
+        if (workers_.empty())
+        {
+            job(0, count);
+            return;
+        }
+
+        count_ = count;
+        job_ = &job;
+        invoke_ = [](void* job, size_t first, size_t last) { (*static_cast<TJob*>(job))(first, last); };
+
+        started_.arrive_and_wait();
+        invoke_(job_, 0, chunk_end(0));
+        finished_.arrive_and_wait();
+    }
+
+private:
+    void run_worker(size_t worker)
+    {
+        while (true)
+        {
+            started_.arrive_and_wait();
+
+            if (stopping_)
+                return;
+
+            invoke_(job_, chunk_begin(worker), chunk_end(worker));
+
+            finished_.arrive_and_wait();
+        }
+    }
+
+    size_t chunk_begin(size_t worker) const
+    {
+        return count_ * worker / workers_count_;
+    }
+
+    size_t chunk_end(size_t worker) const
+    {
+        return count_ * (worker + 1) / workers_count_;
+    }
+};
+
+#endif // SNAKE_CHUNKED_WORKERS_HPP
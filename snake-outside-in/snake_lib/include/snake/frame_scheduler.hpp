@@ -0,0 +1,73 @@
+#ifndef SNAKE_FRAME_SCHEDULER_HPP
+#define SNAKE_FRAME_SCHEDULER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+// Fixed simulation step with independent render pacing - sleeps until the nearest deadline
+class FixedTimestepScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        size_t updates; // simulation steps to run in this frame
+        bool render;
+    };
+
+private:
+    Clock::duration update_step_;
+    Clock::duration render_step_;
+    size_t max_updates_per_frame_;
+    Clock::time_point next_update_;
+    Clock::time_point next_render_;
+
+public:
+    FixedTimestepScheduler(Clock::duration update_step, Clock::duration render_step,
+        size_t max_updates_per_frame = 5, Clock::time_point start = Clock::now())
+        : update_step_{update_step}, render_step_{render_step}, max_updates_per_frame_{max_updates_per_frame}
+        , next_update_{start}, next_render_{start}
+    {}
+
+    Clock::time_point next_deadline() const
+    {
+        return std::min(next_update_, next_render_);
+    }
+
+    Frame wait_for_next_frame()
+    {
+        std::this_thread::sleep_until(next_deadline());
+        return plan_frame(Clock::now());
+    }
+
+    // what is due at given time - deadlines advance by whole steps, so pacing does not drift
+    Frame plan_frame(Clock::time_point now)
+    {
+        Frame frame{0, false};
+
+        while (next_update_ <= now && frame.updates < max_updates_per_frame_)
+        {
+            ++frame.updates;
+            next_update_ += update_step_;
+        }
+
+        if (next_update_ <= now) // too far behind - skip missed steps instead of spiralling
+            next_update_ = now + update_step_;
+
+        if (next_render_ <= now)
+        {
+            frame.render = true;
+            next_render_ += render_step_;
+
+            if (next_render_ <= now)
+                next_render_ = now + render_step_;
+        }
+
+        return frame;
+    }
+};
+
+#endif // SNAKE_FRAME_SCHEDULER_HPP
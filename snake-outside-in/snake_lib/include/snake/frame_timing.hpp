@@ -0,0 +1,199 @@
+#ifndef SNAKE_FRAME_TIMING_HPP
+#define SNAKE_FRAME_TIMING_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+
+// Per-phase frame timing of SnakeGame - enabled with SNAKE_FRAME_TIMING (CMake option of the same name).
+// When disabled, PhaseTimer is an empty object & nothing is measured or recorded.
+#ifdef SNAKE_FRAME_TIMING
+inline constexpr bool frame_timing_enabled = true;
+#else
+inline constexpr bool frame_timing_enabled = false;
+#endif
+
+enum class FramePhase : uint8_t { ReadKey, Clear, Update, Render, Flush };
+
+inline constexpr size_t frame_phase_count = 5;
+
+constexpr std::string_view to_string(FramePhase phase)
+{
+    constexpr std::array<std::string_view, frame_phase_count> names{"read_key", "clear", "update", "render", "flush"};
+    return names[static_cast<size_t>(phase)];
+}
+
+// Durations in ns counted in fixed log-linear buckets: 8 buckets per power of two, so any percentile is
+// within 12.5% of the exact value. Recording is a few bit operations & an increment.
+class DurationHistogram
+{
+    static constexpr unsigned sub_bucket_bits = 3;
+    static constexpr uint64_t sub_buckets = uint64_t{1} << sub_bucket_bits;
+    static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+    std::array<uint64_t, bucket_count> counts_{};
+    uint64_t count_{0};
+    uint64_t max_{0};
+
+public:
+    void record(uint64_t ns)
+    {
+        ++counts_[bucket_of(ns)];
+        ++count_;
+        if (ns > max_)
+            max_ = ns;
+    }
+
+    uint64_t count() const
+    {
+        return count_;
+    }
+
+    uint64_t max() const
+    {
+        return max_;
+    }
+
+    // upper bound of the bucket holding the q-th quantile (q in [0, 1]); 0 when nothing was recorded
+    uint64_t percentile(double q) const
+    {
+        if (count_ == 0)
+            return 0;
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+        {
+            seen += counts_[bucket];
+            if (seen >= rank)
+                return std::min(upper_bound(bucket), max_);
+        }
+
+        return max_;
+    }
+
+    void reset()
+    {
+        *this = DurationHistogram{};
+    }
+
+private:
+    // values below 16 have buckets of their own; above, the top 4 bits select the bucket
+    static size_t bucket_of(uint64_t value)
+    {
+        if (value < sub_buckets)
+            return static_cast<size_t>(value);
+
+        const auto shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+        return static_cast<size_t>((shift + 1) * sub_buckets + ((value >> shift) & (sub_buckets - 1)));
+    }
+
+    static uint64_t upper_bound(size_t bucket)
+    {
+        if (bucket < 2 * sub_buckets)
+            return bucket;
+
+        const auto shift = bucket / sub_buckets - 1;
+        const uint64_t mantissa = sub_buckets + bucket % sub_buckets;
+        return ((mantissa + 1) << shift) - 1;
+    }
+};
+
+class FrameTimings
+{
+    std::array<DurationHistogram, frame_phase_count> histograms_;
+    std::array<uint64_t, frame_phase_count> last_{};
+
+public:
+    void record(FramePhase phase, uint64_t ns)
+    {
+        histograms_[static_cast<size_t>(phase)].record(ns);
+        last_[static_cast<size_t>(phase)] = ns;
+    }
+
+    const DurationHistogram& histogram(FramePhase phase) const
+    {
+        return histograms_[static_cast<size_t>(phase)];
+    }
+
+    // duration of the latest sample
+    uint64_t last(FramePhase phase) const
+    {
+        return last_[static_cast<size_t>(phase)];
+    }
+
+    void reset()
+    {
+        *this = FrameTimings{};
+    }
+
+    // p50/p99/max per phase in microseconds
+    void dump(std::ostream& out) const
+    {
+        const auto flags = out.flags();
+        const auto precision = out.precision();
+
+        out << std::left << std::setw(10) << "phase" << std::right << std::setw(10) << "samples" << std::setw(12)
+            << "p50 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "max [us]" << '\n';
+        out << std::fixed << std::setprecision(1);
+
+        for (size_t i = 0; i < frame_phase_count; ++i)
+        {
+            const auto& histogram = histograms_[i];
+            out << std::left << std::setw(10) << to_string(static_cast<FramePhase>(i)) << std::right << std::setw(10)
+                << histogram.count() << std::setw(12) << histogram.percentile(0.5) / 1000.0 << std::setw(12)
+                << histogram.percentile(0.99) / 1000.0 << std::setw(12) << histogram.max() / 1000.0 << '\n';
+        }
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
+
+// timings of the process - recorded by SnakeGame, shown by terminals
+inline FrameTimings& frame_timings()
+{
+    static FrameTimings timings;
+    return timings;
+}
+
+// Records the duration of its scope as the given phase. steady_clock is used rather than rdtsc - it is
+// portable, does not depend on invariant TSC & costs ~20 ns per sample, far below a frame.
+template <bool Enabled = frame_timing_enabled>
+class PhaseTimer
+{
+    FrameTimings& timings_;
+    FramePhase phase_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit PhaseTimer(FramePhase phase, FrameTimings& timings = frame_timings())
+        : timings_{timings}, phase_{phase}, start_{std::chrono::steady_clock::now()}
+    {}
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    ~PhaseTimer()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        timings_.record(phase_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+template <>
+class PhaseTimer<false>
+{
+public:
+    explicit PhaseTimer(FramePhase)
+    {}
+};
+
+#endif // SNAKE_FRAME_TIMING_HPP
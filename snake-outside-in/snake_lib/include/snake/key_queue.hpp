@@ -0,0 +1,83 @@
+#ifndef SNAKE_KEY_QUEUE_HPP
+#define SNAKE_KEY_QUEUE_HPP
+
+#include "snake/frame_timing.hpp"
+#include "snake/snake.hpp"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Bounded queue of key presses in order of arrival - filled from window events & consumed one key per tick.
+// When full, new presses are dropped (the older ones are already waiting for their turn).
+// Time from press to consumption is recorded as input-to-turn latency.
+template <size_t Capacity>
+class KeyQueue
+{
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct KeyPress
+    {
+        Key key;
+        Clock::time_point pressed;
+    };
+
+    std::array<KeyPress, Capacity> presses_{};
+    size_t head_{0};
+    size_t tail_{0};
+    size_t dropped_{0};
+    DurationHistogram latency_;
+
+public:
+    bool push(Key key, Clock::time_point pressed = Clock::now())
+    {
+        if (size() == Capacity)
+        {
+            ++dropped_;
+            return false;
+        }
+
+        presses_[tail_++ & (Capacity - 1)] = KeyPress{key, pressed};
+        return true;
+    }
+
+    std::optional<Key> pop(Clock::time_point now = Clock::now())
+    {
+        if (empty())
+            return std::nullopt;
+
+        const KeyPress& press = presses_[head_++ & (Capacity - 1)];
+        latency_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - press.pressed).count()));
+        return press.key;
+    }
+
+    size_t size() const
+    {
+        return tail_ - head_;
+    }
+
+    bool empty() const
+    {
+        return head_ == tail_;
+    }
+
+    // presses lost because the queue was full
+    size_t dropped() const
+    {
+        return dropped_;
+    }
+
+    const DurationHistogram& latency() const
+    {
+        return latency_;
+    }
+};
+
+#endif // SNAKE_KEY_QUEUE_HPP
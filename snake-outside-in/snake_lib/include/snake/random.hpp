@@ -0,0 +1,107 @@
+#ifndef SNAKE_RANDOM_HPP
+#define SNAKE_RANDOM_HPP
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** engine - fast, 256-bit state, satisfies UniformRandomBitGenerator
+class Xoshiro256StarStar
+{
+    uint64_t state_[4];
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed)
+    {
+        // state is expanded from the seed with splitmix64 (never all zeros)
+        for (auto& word : state_)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const uint64_t result = std::rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 45);
+
+        return result;
+    }
+
+    // unbiased value from [0, range) - Lemire's multiply & reject method
+    uint32_t bounded(uint32_t range)
+    {
+        uint64_t product = next_u32() * static_cast<uint64_t>(range);
+        uint32_t low = static_cast<uint32_t>(product);
+
+        if (low < range)
+        {
+            const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+            while (low < threshold)
+            {
+                product = next_u32() * static_cast<uint64_t>(range);
+                low = static_cast<uint32_t>(product);
+            }
+        }
+
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // uniformly distributed value from [min, max]
+    int uniform_int(int min, int max)
+    {
+        const auto range = static_cast<uint32_t>(static_cast<int64_t>(max) - min + 1);
+
+        if (range == 0) // full range of int
+            return static_cast<int>(next_u32());
+
+        return static_cast<int>(min + static_cast<int64_t>(bounded(range)));
+    }
+
+private:
+    uint64_t next_u32()
+    {
+        return (*this)() >> 32;
+    }
+};
+
+// Random generator seeded once - the same seed always gives the same sequence (replays, benchmarks)
+class SeededRandomGenerator
+{
+    Xoshiro256StarStar engine_;
+
+public:
+    explicit SeededRandomGenerator(uint64_t seed)
+        : engine_{seed}
+    {}
+
+    int operator()(int min, int max)
+    {
+        return engine_.uniform_int(min, max);
+    }
+};
+
+#endif // SNAKE_RANDOM_HPP
@@ -0,0 +1,286 @@
+#ifndef SNAKE_REPLAY_HPP
+#define SNAKE_REPLAY_HPP
+
+#include "snake/random.hpp"
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Game recorded as a seed of the board's random generator + run-length encoded keys read in each tick
+struct Replay
+{
+    struct KeyRun
+    {
+        uint8_t symbol; // 0 - no key, 1 + Key otherwise
+        uint32_t length;
+
+        bool operator==(const KeyRun&) const = default;
+    };
+
+    uint64_t seed{0};
+    int width{20};
+    int height{10};
+    uint32_t apple_count{0};
+    std::vector<KeyRun> runs;
+
+    Board make_board() const
+    {
+        return Board{width, height, apple_count, SeededRandomGenerator{seed}};
+    }
+
+    void record(std::optional<Key> key)
+    {
+        const uint8_t symbol = key ? static_cast<uint8_t>(1 + static_cast<uint8_t>(*key)) : 0;
+
+        if (!runs.empty() && runs.back().symbol == symbol && runs.back().length < UINT32_MAX)
+            ++runs.back().length;
+        else
+            runs.push_back(KeyRun{symbol, 1});
+    }
+
+    size_t tick_count() const
+    {
+        size_t count = 0;
+        for (const auto& run : runs)
+            count += run.length;
+        return count;
+    }
+
+    // binary format: magic, varint header fields, then one run per record:
+    // 3 bits of symbol + 4 low bits of length (+ continuation bit) followed by LEB128 of the rest of length
+    std::vector<uint8_t> serialize() const
+    {
+        std::vector<uint8_t> bytes{magic_.begin(), magic_.end()};
+
+        write_varint(bytes, seed);
+        write_varint(bytes, static_cast<uint32_t>(width));
+        write_varint(bytes, static_cast<uint32_t>(height));
+        write_varint(bytes, apple_count);
+        write_varint(bytes, runs.size());
+
+        for (const auto& run : runs)
+        {
+            const uint64_t rest = run.length >> 4;
+            bytes.push_back(static_cast<uint8_t>(run.symbol | ((run.length & 0x0F) << 3) | (rest ? 0x80 : 0)));
+            if (rest)
+                write_varint(bytes, rest);
+        }
+
+        return bytes;
+    }
+
+    static Replay deserialize(std::span<const uint8_t> bytes)
+    {
+        if (bytes.size() < magic_.size() || !std::equal(magic_.begin(), magic_.end(), bytes.begin()))
+            throw std::runtime_error("Not a snake replay");
+
+        size_t pos = magic_.size();
+
+        Replay replay;
+        replay.seed = read_varint(bytes, pos);
+        replay.width = static_cast<int>(read_varint(bytes, pos));
+        replay.height = static_cast<int>(read_varint(bytes, pos));
+        replay.apple_count = static_cast<uint32_t>(read_varint(bytes, pos));
+
+        const auto run_count = read_varint(bytes, pos);
+        for (uint64_t i = 0; i < run_count; ++i)
+        {
+            if (pos >= bytes.size())
+                throw std::runtime_error("Truncated snake replay");
+
+            const uint8_t head = bytes[pos++];
+            const auto symbol = static_cast<uint8_t>(head & 0x07);
+            if (symbol > max_symbol_)
+                throw std::runtime_error("Invalid key in snake replay");
+
+            uint64_t length = (head >> 3) & 0x0F;
+            if (head & 0x80)
+            {
+                const uint64_t rest = read_varint(bytes, pos);
+                if (rest > (UINT32_MAX >> 4))
+                    throw std::runtime_error("Run too long in snake replay");
+                length |= rest << 4;
+            }
+
+            // empty runs would stall the playback
+            if (length == 0)
+                throw std::runtime_error("Empty run in snake replay");
+
+            replay.runs.push_back(KeyRun{symbol, static_cast<uint32_t>(length)});
+        }
+
+        return replay;
+    }
+
+    bool operator==(const Replay&) const = default;
+
+private:
+    static constexpr std::string_view magic_{"SNKR"};
+    static constexpr uint8_t max_symbol_ = 1 + static_cast<uint8_t>(Key::ArrowRight);
+
+    static void write_varint(std::vector<uint8_t>& bytes, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t read_varint(std::span<const uint8_t> bytes, size_t& pos)
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= bytes.size())
+                throw std::runtime_error("Truncated snake replay");
+
+            const uint8_t byte = bytes[pos++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+
+        throw std::runtime_error("Invalid varint in snake replay");
+    }
+};
+
+// Terminal that renders nothing - games run headless at maximum speed
+struct NullTerminal
+{
+    std::optional<Key> read_key()
+    {
+        return std::nullopt;
+    }
+
+    void clear()
+    {}
+
+    void render_board(const Board&)
+    {}
+
+    template <typename TSnake>
+    void render_snake(const TSnake&)
+    {}
+
+    void render_text(const std::vector<std::string>&)
+    {}
+
+    void flush()
+    {}
+};
+
+// Forwards everything to the wrapped terminal and records keys read in each tick
+template <typename TTerminal>
+class RecordingTerminal
+{
+    TTerminal& terminal_;
+    Replay& replay_;
+
+public:
+    RecordingTerminal(TTerminal& terminal, Replay& replay)
+        : terminal_{terminal}, replay_{replay}
+    {}
+
+    std::optional<Key> read_key()
+    {
+        auto key = terminal_.read_key();
+        replay_.record(key);
+        return key;
+    }
+
+    void clear()
+    {
+        terminal_.clear();
+    }
+
+    void render_board(const Board& board)
+    {
+        terminal_.render_board(board);
+    }
+
+    template <typename TSnake>
+    void render_snake(const TSnake& snake)
+    {
+        terminal_.render_snake(snake);
+    }
+
+    void render_text(const std::vector<std::string>& lines)
+    {
+        terminal_.render_text(lines);
+    }
+
+    void flush()
+    {
+        terminal_.flush();
+    }
+};
+
+// Feeds keys from a replay (Q when it ends) - rendering goes to the wrapped terminal
+template <typename TTerminal = NullTerminal>
+class ReplayingTerminal
+{
+    TTerminal& terminal_;
+    const Replay& replay_;
+    size_t run_index_{0};
+    uint32_t run_position_{0};
+
+public:
+    ReplayingTerminal(TTerminal& terminal, const Replay& replay)
+        : terminal_{terminal}, replay_{replay}
+    {}
+
+    std::optional<Key> read_key()
+    {
+        if (run_index_ == replay_.runs.size())
+            return Key::Q;
+
+        const auto symbol = replay_.runs[run_index_].symbol;
+        if (++run_position_ == replay_.runs[run_index_].length)
+        {
+            ++run_index_;
+            run_position_ = 0;
+        }
+
+        if (symbol == 0)
+            return std::nullopt;
+
+        return static_cast<Key>(symbol - 1);
+    }
+
+    void clear()
+    {
+        terminal_.clear();
+    }
+
+    void render_board(const Board& board)
+    {
+        terminal_.render_board(board);
+    }
+
+    template <typename TSnake>
+    void render_snake(const TSnake& snake)
+    {
+        terminal_.render_snake(snake);
+    }
+
+    void render_text(const std::vector<std::string>& lines)
+    {
+        terminal_.render_text(lines);
+    }
+
+    void flush()
+    {
+        terminal_.flush();
+    }
+};
+
+#endif // SNAKE_REPLAY_HPP
@@ -0,0 +1,318 @@
+#ifndef SNAKE_RING_BUFFER_HPP
+#define SNAKE_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Growable circular buffer - O(1) push_front & pop_back, capacity doubles when full
+template <typename T>
+class RingBuffer
+{
+    std::unique_ptr<T[]> items_;
+    size_t capacity_{0}; // always a power of two (or zero)
+    size_t head_{0};
+    size_t size_{0};
+
+public:
+    template <typename TValue>
+    class Iterator
+    {
+        TValue* items_{nullptr};
+        size_t mask_{0};
+        size_t position_{0};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<TValue>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = TValue*;
+        using reference = TValue&;
+
+        Iterator() = default;
+
+        Iterator(TValue* items, size_t mask, size_t position)
+            : items_{items}, mask_{mask}, position_{position}
+        {}
+
+        reference operator*() const
+        {
+            return items_[position_ & mask_];
+        }
+
+        pointer operator->() const
+        {
+            return &items_[position_ & mask_];
+        }
+
+        Iterator& operator++()
+        {
+            ++position_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp{*this};
+            ++position_;
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return position_ == other.position_;
+        }
+    };
+
+    using value_type = T;
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    RingBuffer() = default;
+
+    template <std::forward_iterator TIterator>
+    RingBuffer(TIterator first, TIterator last)
+    {
+        reserve(static_cast<size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    RingBuffer(const RingBuffer& other)
+    {
+        reserve(other.size_);
+        for (const auto& item : other)
+            push_back(item);
+    }
+
+    RingBuffer& operator=(const RingBuffer& other)
+    {
+        if (this != &other)
+        {
+            RingBuffer temp{other};
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept
+        : items_{std::move(other.items_)}
+        , capacity_{std::exchange(other.capacity_, 0)}
+        , head_{std::exchange(other.head_, 0)}
+        , size_{std::exchange(other.size_, 0)}
+    {}
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept
+    {
+        RingBuffer temp{std::move(other)};
+        swap(temp);
+        return *this;
+    }
+
+    void swap(RingBuffer& other) noexcept
+    {
+        std::swap(items_, other.items_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return items_[(head_ + index) & mask()];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[(head_ + index) & mask()];
+    }
+
+    T& front()
+    {
+        return (*this)[0];
+    }
+
+    const T& front() const
+    {
+        return (*this)[0];
+    }
+
+    T& back()
+    {
+        return (*this)[size_ - 1];
+    }
+
+    const T& back() const
+    {
+        return (*this)[size_ - 1];
+    }
+
+    void push_front(const T& item)
+    {
+        if (size_ == capacity_)
+            grow();
+
+        head_ = (head_ - 1) & mask();
+        items_[head_] = item;
+        ++size_;
+    }
+
+    void push_back(const T& item)
+    {
+        if (size_ == capacity_)
+            grow();
+
+        items_[(head_ + size_) & mask()] = item;
+        ++size_;
+    }
+
+    void pop_back()
+    {
+        --size_;
+    }
+
+    void pop_front()
+    {
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > capacity_)
+            reallocate(std::bit_ceil(capacity));
+    }
+
+    iterator begin()
+    {
+        return {items_.get(), mask(), head_};
+    }
+
+    iterator end()
+    {
+        return {items_.get(), mask(), head_ + size_};
+    }
+
+    const_iterator begin() const
+    {
+        return {items_.get(), mask(), head_};
+    }
+
+    const_iterator end() const
+    {
+        return {items_.get(), mask(), head_ + size_};
+    }
+
+    // items as (at most) two contiguous parts: [head, end of storage) & [start of storage, tail]
+    std::pair<std::span<const T>, std::span<const T>> as_spans() const
+    {
+        if (size_ == 0)
+            return {};
+
+        const size_t first_size = std::min(size_, capacity_ - head_);
+        return {std::span<const T>{items_.get() + head_, first_size}, std::span<const T>{items_.get(), size_ - first_size}};
+    }
+
+    bool operator==(const RingBuffer& other) const
+    {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+
+private:
+    size_t mask() const
+    {
+        return capacity_ - 1;
+    }
+
+    void grow()
+    {
+        reallocate(capacity_ == 0 ? 4 : capacity_ * 2);
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        auto new_items = std::make_unique<T[]>(new_capacity);
+        for (size_t i = 0; i < size_; ++i)
+            new_items[i] = std::move((*this)[i]);
+
+        items_ = std::move(new_items);
+        capacity_ = new_capacity;
+        head_ = 0;
+    }
+};
+
+// Non-owning, read-only view of a ring buffer - iterating does not allocate
+template <typename T>
+class RingBufferView : public std::ranges::view_interface<RingBufferView<T>>
+{
+    const RingBuffer<T>* buffer_{nullptr};
+
+public:
+    RingBufferView() = default;
+
+    explicit RingBufferView(const RingBuffer<T>& buffer)
+        : buffer_{&buffer}
+    {}
+
+    auto begin() const
+    {
+        return buffer_->begin();
+    }
+
+    auto end() const
+    {
+        return buffer_->end();
+    }
+
+    size_t size() const
+    {
+        return buffer_->size();
+    }
+
+    std::pair<std::span<const T>, std::span<const T>> as_spans() const
+    {
+        return buffer_->as_spans();
+    }
+
+    operator std::vector<T>() const
+    {
+        return {begin(), end()};
+    }
+
+    template <std::ranges::input_range TRange>
+    bool operator==(const TRange& other) const
+    {
+        return std::ranges::equal(*this, other);
+    }
+};
+
+#endif // SNAKE_RING_BUFFER_HPP
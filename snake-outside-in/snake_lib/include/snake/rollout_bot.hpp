@@ -0,0 +1,237 @@
+#ifndef SNAKE_ROLLOUT_BOT_HPP
+#define SNAKE_ROLLOUT_BOT_HPP
+
+#include "snake/chunked_workers.hpp"
+#include "snake/random.hpp"
+#include "snake/snake.hpp"
+#include "snake/snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct RolloutSettings
+{
+    std::chrono::microseconds time_budget{std::chrono::milliseconds(10)}; // per move
+    size_t max_playouts{std::numeric_limits<size_t>::max()};               // per move
+    size_t depth{100};                                                     // moves of one playout
+    double apple_weight{10.0};                                             // eaten apple is worth that many moves
+    uint64_t seed{1};
+};
+
+// Monte Carlo player: from the current state many short playouts are run for each possible move
+// (half greedy towards the nearest apple, half random, never into an obvious collision) and the move with
+// the best mean of survived moves + weighted apples is chosen.
+// Playouts are handed out to worker threads in small batches from a shared counter, so threads that are
+// done early take more of them; every thread plays on its own board restored from a snapshot of the game.
+// Each playout is seeded from (seed, decision, playout), a restored board places apples the same way whatever
+// playouts ran on it before, and outcomes are summed as integers - so the chosen move does not depend on
+// thread count or scheduling, as long as max_playouts, not the time budget, ends the search
+// (with a time budget the number of playouts depends on the machine).
+class RolloutBot
+{
+    static constexpr std::array<Direction, 4> directions_{Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+    static constexpr size_t playouts_per_batch = 8;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct alignas(64) Worker
+    {
+        Xoshiro256StarStar engine;
+        Board board; // new apples in playouts are placed with the worker's engine
+        Snake snake;
+        std::array<uint64_t, 4> survived{}; // moves survived & apples eaten summed over playouts
+        std::array<uint64_t, 4> apples{};
+        std::array<uint64_t, 4> playouts{};
+
+        Worker(const Board& game_board, uint64_t seed)
+            : engine{seed}
+            , board{game_board.width(), game_board.height(), 0, [this](int min, int max) { return engine.uniform_int(min, max); }}
+            , snake{board}
+        {}
+    };
+
+    const Board& board_;
+    const Snake& snake_;
+    RolloutSettings settings_;
+    Snapshot game_state_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    ChunkedWorkers threads_;
+    std::array<Direction, 3> candidates_{};
+    std::atomic<size_t> next_playout_{0};
+    Clock::time_point deadline_;
+    uint64_t decision_{0};
+    size_t last_playouts_{0};
+
+public:
+    RolloutBot(const Board& board, const Snake& snake, RolloutSettings settings = {},
+        size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        : board_{board}, snake_{snake}, settings_{settings}, threads_{thread_count}
+    {
+        for (size_t i = 0; i < threads_.thread_count(); ++i)
+            workers_.push_back(std::make_unique<Worker>(board, settings.seed + i * 0x9e3779b97f4a7c15ULL));
+    }
+
+    Direction next_direction()
+    {
+        game_state_.save(board_, snake_);
+
+        const Direction opposite = opposite_of(snake_.direction());
+        std::ranges::copy_if(directions_, candidates_.begin(), [opposite](Direction d) { return d != opposite; });
+
+        next_playout_.store(0, std::memory_order_relaxed);
+        deadline_ = Clock::now() + settings_.time_budget;
+        ++decision_;
+
+        auto play = [this](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+                run_playouts(*workers_[i]);
+        };
+        threads_.run(workers_.size(), play);
+
+        std::array<uint64_t, 4> survived{};
+        std::array<uint64_t, 4> apples{};
+        std::array<uint64_t, 4> playouts{};
+        for (auto& worker : workers_)
+        {
+            for (size_t c = 0; c < candidates_.size(); ++c)
+            {
+                survived[c] += std::exchange(worker->survived[c], 0);
+                apples[c] += std::exchange(worker->apples[c], 0);
+                playouts[c] += std::exchange(worker->playouts[c], 0);
+            }
+        }
+
+        last_playouts_ = 0;
+        Direction best = snake_.direction();
+        double best_score = -1.0;
+        for (size_t c = 0; c < candidates_.size(); ++c)
+        {
+            last_playouts_ += playouts[c];
+            if (playouts[c] == 0)
+                continue;
+
+            const double score = (static_cast<double>(survived[c]) + settings_.apple_weight * static_cast<double>(apples[c]))
+                / static_cast<double>(playouts[c]);
+            if (score > best_score)
+            {
+                best_score = score;
+                best = candidates_[c];
+            }
+        }
+
+        return best;
+    }
+
+    // number of playouts behind the last decision
+    size_t last_playouts() const
+    {
+        return last_playouts_;
+    }
+
+    size_t thread_count() const
+    {
+        return workers_.size();
+    }
+
+private:
+    void run_playouts(Worker& worker)
+    {
+        while (true)
+        {
+            const size_t first = next_playout_.fetch_add(playouts_per_batch, std::memory_order_relaxed);
+            if (first >= settings_.max_playouts || Clock::now() >= deadline_)
+                return;
+
+            const size_t last = std::min(first + playouts_per_batch, settings_.max_playouts);
+            for (size_t playout = first; playout < last; ++playout)
+            {
+                const size_t candidate = playout % candidates_.size();
+                worker.engine = Xoshiro256StarStar{playout_seed(playout)};
+
+                const auto [survived, apples] = play(worker, candidates_[candidate]);
+                worker.survived[candidate] += survived;
+                worker.apples[candidate] += apples;
+                ++worker.playouts[candidate];
+            }
+        }
+    }
+
+    uint64_t playout_seed(size_t playout) const
+    {
+        return settings_.seed ^ (decision_ * 0x9e3779b97f4a7c15ULL) ^ (static_cast<uint64_t>(playout) * 0xbf58476d1ce4e5b9ULL);
+    }
+
+    // moves survived & apples eaten
+    std::pair<uint64_t, uint64_t> play(Worker& worker, Direction first_move) const
+    {
+        game_state_.restore(worker.board, worker.snake);
+        const size_t length = worker.snake.segments().size();
+
+        size_t survived = 0;
+        worker.snake.move(first_move);
+        while (worker.snake.is_alive() && survived < settings_.depth)
+        {
+            ++survived;
+            worker.snake.move(rollout_direction(worker));
+        }
+
+        return {survived, worker.snake.segments().size() - length};
+    }
+
+    static Direction rollout_direction(Worker& worker)
+    {
+        const Snake& snake = worker.snake;
+        const Board& board = worker.board;
+
+        std::array<Direction, 3> safe{};
+        size_t safe_count = 0;
+        for (Direction direction : directions_)
+        {
+            if (direction == opposite_of(snake.direction()))
+                continue;
+
+            const Point next = snake.next_head(direction);
+            if (!board.is_hitting_walls(next) && !board.has_snake_segment(next))
+                safe[safe_count++] = direction;
+        }
+
+        if (safe_count == 0)
+            return snake.direction();
+
+        if (board.apples().empty() || worker.engine.bounded(2) == 0)
+            return safe[worker.engine.bounded(static_cast<uint32_t>(safe_count))];
+
+        const Point head = snake.head();
+        auto distance = [](const Point& a, const Point& b) { return std::abs(a.x - b.x) + std::abs(a.y - b.y); };
+        const Point apple = *std::ranges::min_element(board.apples(), {}, [&](const Point& a) { return distance(a, head); });
+
+        return *std::ranges::min_element(safe.begin(), safe.begin() + safe_count, {},
+            [&](Direction direction) { return distance(apple, snake.next_head(direction)); });
+    }
+
+    static Direction opposite_of(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::Up:
+            return Direction::Down;
+        case Direction::Down:
+            return Direction::Up;
+        case Direction::Left:
+            return Direction::Right;
+        default:
+            return Direction::Left;
+        }
+    }
+};
+
+#endif // SNAKE_ROLLOUT_BOT_HPP
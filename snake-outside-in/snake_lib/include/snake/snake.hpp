@@ -3,14 +3,23 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <random>
+#include <span>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <optional>
 #include <functional>
+#include <utility>
+
+#include "snake/frame_timing.hpp"
+#include "snake/random.hpp"
+#include "snake/ring_buffer.hpp"
 
 enum class Key {
     P,
@@ -40,27 +49,337 @@ std::ostream& operator<<(std::ostream& os, const Point& pt)
     return os << "Point(" << pt.x << ", " << pt.y << ")";
 }
 
+enum class Cell : uint8_t {
+    Empty = 0,
+    Apple = 1 << 0,
+    Snake = 1 << 1
+};
+
+// Key of a cell (or a tile) in hash maps - coordinates packed into 64 bits
+constexpr uint64_t cell_key(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(y)) << 32) | static_cast<uint32_t>(x);
+}
+
+struct CellKeyHash
+{
+    size_t operator()(uint64_t key) const noexcept
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+};
+
+// Map of board cells - each cell is packed into 2 bits (apple & snake flags).
+// Boards up to max_dense_cells are a dense array of words; bigger ones group cells in 16x16 tiles
+// (a cache line each) allocated on first use & released when emptied, so memory scales with
+// the occupied area, not with width * height.
+class OccupancyGrid
+{
+    static constexpr size_t bits_per_cell = 2;
+    static constexpr size_t cells_per_word = 64 / bits_per_cell;
+    static constexpr int tile_shift = 4;
+    static constexpr int tile_size = 1 << tile_shift;
+    static constexpr uint64_t cell_mask = (1u << bits_per_cell) - 1;
+
+    struct Tile
+    {
+        std::array<uint64_t, tile_size * tile_size / cells_per_word> words{};
+        uint32_t occupied_cells{0};
+
+        bool operator==(const Tile&) const = default;
+    };
+
+    int width_, height_;
+    bool is_sparse_;
+    std::vector<uint64_t> words_; // dense grid
+    std::unordered_map<uint64_t, Tile, CellKeyHash> tiles_; // sparse grid
+
+public:
+    static constexpr size_t max_dense_cells = size_t{1} << 22;
+
+    OccupancyGrid(int width, int height)
+        : width_{width}, height_{height}
+        , is_sparse_{static_cast<size_t>(std::max(width, 0)) * static_cast<size_t>(std::max(height, 0)) > max_dense_cells}
+        , words_(is_sparse_ ? 0 : (static_cast<size_t>(width) * static_cast<size_t>(height) + cells_per_word - 1) / cells_per_word)
+    {}
+
+    bool contains(const Point& pt) const
+    {
+        return pt.x >= 0 && pt.x < width_ && pt.y >= 0 && pt.y < height_;
+    }
+
+    bool has(const Point& pt, Cell cell) const
+    {
+        return cell_at(pt) & static_cast<uint64_t>(cell);
+    }
+
+    bool is_empty(const Point& pt) const
+    {
+        return cell_at(pt) == 0;
+    }
+
+    void add(const Point& pt, Cell cell)
+    {
+        if (!contains(pt))
+            return;
+
+        if (!is_sparse_)
+        {
+            auto [word, shift] = locate_dense(pt);
+            words_[word] |= static_cast<uint64_t>(cell) << shift;
+            return;
+        }
+
+        Tile& tile = tiles_[tile_key(pt)];
+        auto [word, shift] = locate(pt);
+
+        if (((tile.words[word] >> shift) & cell_mask) == 0)
+            ++tile.occupied_cells;
+
+        tile.words[word] |= static_cast<uint64_t>(cell) << shift;
+    }
+
+    void remove(const Point& pt, Cell cell)
+    {
+        if (!contains(pt))
+            return;
+
+        if (!is_sparse_)
+        {
+            auto [word, shift] = locate_dense(pt);
+            words_[word] &= ~(static_cast<uint64_t>(cell) << shift);
+            return;
+        }
+
+        auto it = tiles_.find(tile_key(pt));
+        if (it == tiles_.end())
+            return;
+
+        Tile& tile = it->second;
+        auto [word, shift] = locate(pt);
+
+        if (((tile.words[word] >> shift) & cell_mask) == 0)
+            return;
+
+        tile.words[word] &= ~(static_cast<uint64_t>(cell) << shift);
+
+        if (((tile.words[word] >> shift) & cell_mask) == 0 && --tile.occupied_cells == 0)
+            tiles_.erase(it);
+    }
+
+    bool is_sparse() const
+    {
+        return is_sparse_;
+    }
+
+    size_t tile_count() const
+    {
+        return tiles_.size();
+    }
+
+    size_t memory_usage() const
+    {
+        return words_.size() * sizeof(uint64_t) + tiles_.size() * sizeof(Tile);
+    }
+
+    bool operator==(const OccupancyGrid&) const = default;
+
+private:
+    uint64_t cell_at(const Point& pt) const
+    {
+        if (!contains(pt))
+            return 0;
+
+        if (!is_sparse_)
+        {
+            auto [word, shift] = locate_dense(pt);
+            return (words_[word] >> shift) & cell_mask;
+        }
+
+        auto it = tiles_.find(tile_key(pt));
+        if (it == tiles_.end())
+            return 0;
+
+        auto [word, shift] = locate(pt);
+        return (it->second.words[word] >> shift) & cell_mask;
+    }
+
+    std::pair<size_t, size_t> locate_dense(const Point& pt) const
+    {
+        const auto index = static_cast<size_t>(pt.y) * static_cast<size_t>(width_) + static_cast<size_t>(pt.x);
+        return {index / cells_per_word, (index % cells_per_word) * bits_per_cell};
+    }
+
+    static uint64_t tile_key(const Point& pt)
+    {
+        return cell_key(pt.x >> tile_shift, pt.y >> tile_shift);
+    }
+
+    static std::pair<size_t, size_t> locate(const Point& pt)
+    {
+        const auto index = static_cast<size_t>(pt.y & (tile_size - 1)) * tile_size + static_cast<size_t>(pt.x & (tile_size - 1));
+        return {index / cells_per_word, (index % cells_per_word) * bits_per_cell};
+    }
+};
+
+// Set of free inner cells (x in [1, width), y in [1, height)) - a bit per cell & a Fenwick tree of free cells
+// per 64-cell block, so insert, erase & access to the n-th free cell (in row-major order) take O(log n).
+// The order depends only on which cells are free, never on the order of edits - apples placed through
+// the index are the same after restoring a snapshot. Memory is ~1.5 bits per cell.
+class FreeCellIndex
+{
+    static constexpr size_t cells_per_block = 64;
+
+    int inner_width_, inner_height_;
+    size_t free_count_;
+    std::vector<uint64_t> free_bits_;
+    std::vector<uint32_t> block_tree_; // Fenwick tree (1-based) of free cells per block
+
+public:
+    FreeCellIndex(int width, int height)
+        : inner_width_{std::max(width - 1, 0)}, inner_height_{std::max(height - 1, 0)}
+        , free_count_{static_cast<size_t>(inner_width_) * static_cast<size_t>(inner_height_)}
+        , free_bits_((free_count_ + cells_per_block - 1) / cells_per_block, ~uint64_t{0})
+        , block_tree_(free_bits_.size() + 1)
+    {
+        if (free_count_ % cells_per_block != 0)
+            free_bits_.back() = (uint64_t{1} << (free_count_ % cells_per_block)) - 1;
+
+        // linear construction - every node passes its sum to the parent
+        for (size_t block = 1; block < block_tree_.size(); ++block)
+        {
+            block_tree_[block] += static_cast<uint32_t>(std::popcount(free_bits_[block - 1]));
+            const size_t parent = block + (block & (~block + 1));
+            if (parent < block_tree_.size())
+                block_tree_[parent] += block_tree_[block];
+        }
+    }
+
+    size_t size() const
+    {
+        return free_count_;
+    }
+
+    bool empty() const
+    {
+        return free_count_ == 0;
+    }
+
+    bool contains(const Point& pt) const
+    {
+        return is_inner(pt) && is_free(cell_of(pt));
+    }
+
+    // n-th free cell in row-major order
+    Point operator[](size_t position) const
+    {
+        size_t block = 0;
+        for (size_t step = std::bit_floor(block_tree_.size() - 1); step > 0; step /= 2)
+        {
+            if (block + step < block_tree_.size() && block_tree_[block + step] <= position)
+            {
+                block += step;
+                position -= block_tree_[block];
+            }
+        }
+
+        uint64_t bits = free_bits_[block];
+        for (; position > 0; --position)
+            bits &= bits - 1;
+
+        return point_of(block * cells_per_block + static_cast<size_t>(std::countr_zero(bits)));
+    }
+
+    void insert(const Point& pt)
+    {
+        if (!is_inner(pt) || is_free(cell_of(pt)))
+            return;
+
+        const size_t cell = cell_of(pt);
+        free_bits_[cell / cells_per_block] |= uint64_t{1} << (cell % cells_per_block);
+        update_tree(cell / cells_per_block, 1);
+        ++free_count_;
+    }
+
+    void erase(const Point& pt)
+    {
+        if (!is_inner(pt) || !is_free(cell_of(pt)))
+            return;
+
+        const size_t cell = cell_of(pt);
+        free_bits_[cell / cells_per_block] &= ~(uint64_t{1} << (cell % cells_per_block));
+        update_tree(cell / cells_per_block, -1);
+        --free_count_;
+    }
+
+    size_t memory_usage() const
+    {
+        return free_bits_.size() * sizeof(uint64_t) + block_tree_.size() * sizeof(uint32_t);
+    }
+
+    bool operator==(const FreeCellIndex&) const = default;
+
+private:
+    bool is_inner(const Point& pt) const
+    {
+        return pt.x >= 1 && pt.x <= inner_width_ && pt.y >= 1 && pt.y <= inner_height_;
+    }
+
+    bool is_free(size_t cell) const
+    {
+        return (free_bits_[cell / cells_per_block] >> (cell % cells_per_block)) & 1;
+    }
+
+    void update_tree(size_t block, int delta)
+    {
+        for (size_t node = block + 1; node < block_tree_.size(); node += node & (~node + 1))
+            block_tree_[node] += static_cast<uint32_t>(delta);
+    }
+
+    size_t cell_of(const Point& pt) const
+    {
+        return static_cast<size_t>(pt.y - 1) * static_cast<size_t>(inner_width_) + static_cast<size_t>(pt.x - 1);
+    }
+
+    Point point_of(size_t cell) const
+    {
+        return Point{static_cast<int>(cell % static_cast<size_t>(inner_width_)) + 1,
+            static_cast<int>(cell / static_cast<size_t>(inner_width_)) + 1};
+    }
+};
+
 using IRandomGenerator = std::function<int(int, int)>;
 
 auto RandomGenerator = [](int min, int max) {
-    static std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(min, max);
-    return dis(gen);
+    thread_local Xoshiro256StarStar engine{std::random_device{}()};
+    return engine.uniform_int(min, max);
 };
 
 struct Board 
 {
+    static constexpr int max_apple_placement_attempts = 64;
+
     int width_, height_;
     std::vector<Point> apples_;
+    uint64_t apples_revision_{0}; // changes whenever apple is added or eaten
     IRandomGenerator rnd_generator_;
+private:
+    OccupancyGrid cells_;
+    std::optional<FreeCellIndex> free_cells_; // only for densely stored boards - huge ones are sparse
+    std::unordered_map<uint64_t, uint32_t, CellKeyHash> apple_indexes_; // position of apple in apples_
 public:
     Board(int width = 20, int height = 10, size_t apple_count = 0, IRandomGenerator rnd_gen = RandomGenerator) 
-        : width_{width}, height_{height}, rnd_generator_{rnd_gen}
+        : width_{width}, height_{height}, rnd_generator_{rnd_gen}, cells_{width + 1, height + 1}
     {
+        if (!cells_.is_sparse())
+            free_cells_.emplace(width, height);
+
         for (size_t i = 0; i < apple_count; ++i)
         {
-            apples_.push_back({rnd_generator_(1, width - 1), rnd_generator_(1, height - 1)});
+            add_apple();
         }
     }
 
@@ -79,26 +398,85 @@ public:
         return apples_;
     }
 
+    uint64_t apples_revision() const
+    {
+        return apples_revision_;
+    }
+
     bool has_apple(const Point& apple) const
     {
-        return std::ranges::find(apples_, apple) != apples_.end();
+        return cells_.has(apple, Cell::Apple);
     }
 
+    // apple is placed on a random empty cell - a random cell is taken if it is empty, otherwise a random one
+    // from the free-cell index; each of F empty cells out of N is chosen with P = 1/N + (N - F)/N * 1/F = 1/F.
+    // Boards too big for the index are sparse, so a few retries are enough (apple may be skipped when full).
     void add_apple()
     {
-        apples_.push_back(Point{rnd_generator_(1, width_ - 1), rnd_generator_(1, height_ - 1)});
+        auto apple = random_empty_cell();
+        if (!apple)
+            return;
+
+        apple_indexes_.emplace(cell_key(apple->x, apple->y), static_cast<uint32_t>(apples_.size()));
+        apples_.push_back(*apple);
+        cells_.add(*apple, Cell::Apple);
+        erase_free_cell(*apple);
+        ++apples_revision_;
+    }
+
+    // cells are stored densely (with the free-cell index) up to OccupancyGrid::max_dense_cells, sparsely above
+    size_t occupancy_memory_usage() const
+    {
+        return cells_.memory_usage() + (free_cells_ ? free_cells_->memory_usage() : 0);
+    }
+
+    size_t free_cell_count() const
+    {
+        return free_cells_ ? free_cells_->size() : 0;
     }
 
     bool try_eat_apple(const Point& point)
     {
-        auto it = std::ranges::find(apples_, point);
-        if (it != apples_.end())
+        if (!cells_.has(point, Cell::Apple))
+            return false;
+
+        auto it = apple_indexes_.find(cell_key(point.x, point.y));
+        if (it == apple_indexes_.end())
+            return false;
+
+        // the last apple takes place of the eaten one
+        const uint32_t index = it->second;
+        apple_indexes_.erase(it);
+
+        if (index + 1 != apples_.size())
         {
-            apples_.erase(it);
-            return true;
+            apples_[index] = apples_.back();
+            apple_indexes_[cell_key(apples_[index].x, apples_[index].y)] = index;
         }
+        apples_.pop_back();
 
-        return false;
+        cells_.remove(point, Cell::Apple);
+        insert_free_cell(point);
+
+        ++apples_revision_;
+        return true;
+    }
+
+    bool has_snake_segment(const Point& point) const
+    {
+        return cells_.has(point, Cell::Snake);
+    }
+
+    void place_snake_segment(const Point& point)
+    {
+        cells_.add(point, Cell::Snake);
+        erase_free_cell(point);
+    }
+
+    void remove_snake_segment(const Point& point)
+    {
+        cells_.remove(point, Cell::Snake);
+        insert_free_cell(point);
     }
 
 
@@ -107,34 +485,109 @@ public:
         return point.x <= 0 || point.x >= width_ || point.y <= 0 || point.y >= height_;
     }
 
-    bool operator==(const Board&) const = default;
+    // apples are replaced & set in given order - only cells of the current & restored apples are touched,
+    // so restoring costs O(apples) whatever the board size (snake cells are replaced by Snake::restore());
+    // apple index keeps entries of apples that stay, so restoring a recent state does not allocate
+    void restore(std::span<const Point> apples, uint64_t apples_revision)
+    {
+        for (const auto& apple : apples_)
+        {
+            cells_.remove(apple, Cell::Apple);
+            insert_free_cell(apple);
+        }
+
+        for (size_t i = 0; i < apples.size(); ++i)
+        {
+            apple_indexes_[cell_key(apples[i].x, apples[i].y)] = static_cast<uint32_t>(i);
+            cells_.add(apples[i], Cell::Apple);
+            erase_free_cell(apples[i]);
+        }
+
+        for (const auto& apple : apples_)
+        {
+            auto it = apple_indexes_.find(cell_key(apple.x, apple.y));
+            if (it != apple_indexes_.end() && (it->second >= apples.size() || apples[it->second] != apple))
+                apple_indexes_.erase(it);
+        }
+
+        apples_.assign(apples.begin(), apples.end());
+        apples_revision_ = apples_revision;
+    }
+
+    // boards with the same cells & apples are equal - internal indexes are not compared
+    bool operator==(const Board& other) const
+    {
+        return width_ == other.width_ && height_ == other.height_ && apples_ == other.apples_ && cells_ == other.cells_;
+    }
+
+private:
+    std::optional<Point> random_empty_cell()
+    {
+        Point cell{rnd_generator_(1, width_ - 1), rnd_generator_(1, height_ - 1)};
+        if (cells_.is_empty(cell))
+            return cell;
+
+        if (free_cells_)
+        {
+            if (free_cells_->empty())
+                return std::nullopt;
+
+            return (*free_cells_)[static_cast<size_t>(rnd_generator_(0, static_cast<int>(free_cells_->size()) - 1))];
+        }
+
+        for (int attempt = 1; attempt < max_apple_placement_attempts; ++attempt)
+        {
+            cell = Point{rnd_generator_(1, width_ - 1), rnd_generator_(1, height_ - 1)};
+            if (cells_.is_empty(cell))
+                return cell;
+        }
+
+        return std::nullopt;
+    }
+
+    void insert_free_cell(const Point& point)
+    {
+        if (free_cells_ && cells_.is_empty(point))
+            free_cells_->insert(point);
+    }
+
+    void erase_free_cell(const Point& point)
+    {
+        if (free_cells_)
+            free_cells_->erase(point);
+    }
 };
 
-struct Snake
+// Snake works with any board providing Board's interface (e.g. StaticBoard<W, H> with bitboards)
+template <typename TBoard>
+struct BasicSnake
 {
-    Board& board_;
-    std::vector<Point> segments_;
+    TBoard& board_;
+    RingBuffer<Point> segments_; // head at front, tail at back
     Direction direction_;
     bool is_alive_{true};
 public:
-    explicit Snake(Board& board)
-        : Snake{board, Point{board.width() / 2, board.height() / 2}, Direction::Up}
+    explicit BasicSnake(TBoard& board)
+        : BasicSnake{board, Point{board.width() / 2, board.height() / 2}, Direction::Up}
     {}
 
-    Snake(Board& board, Point head, Direction direction)
+    BasicSnake(TBoard& board, Point head, Direction direction)
         : board_{board}, direction_{direction}
     {
         segments_.push_back(head);
         segments_.push_back(new_segment_from(head, opposite_direction(direction_)));
+        place_on_board();
     }
 
-    Snake(Board& board, std::vector<Point> segments, Direction direction)
-        : board_{board}, segments_{std::move(segments)}, direction_{direction}
-    {}
+    BasicSnake(TBoard& board, std::vector<Point> segments, Direction direction)
+        : board_{board}, segments_{segments.begin(), segments.end()}, direction_{direction}
+    {
+        place_on_board();
+    }
     
-    const std::vector<Point> segments() const
+    RingBufferView<Point> segments() const
     {
-        return segments_;
+        return RingBufferView<Point>{segments_};
     }
 
     Direction direction() const
@@ -152,6 +605,11 @@ public:
         return segments_.front();
     }
 
+    const Point& tail() const
+    {
+        return segments_.back();
+    }
+
     void move(Direction direction)
     {
         direction_ = update_direction(direction);
@@ -164,21 +622,74 @@ public:
             return;
         }
 
-        segments_.insert(segments_.begin(), new_head);
-
-        if (board_.try_eat_apple(new_head))
+        if (advance_to(new_head))
         {            
             board_.add_apple();
             board_.add_apple();
         }
-        else
-        {
-            segments_.pop_back();
-        }
     }
 
-    bool operator==(const Snake&) const = default;
+    // head after moving in the direction - nothing changes (first phase of simultaneous moves)
+    Point next_head(Direction direction) const
+    {
+        return new_segment_from(segments_.front(), update_direction(direction));
+    }
+
+    // moves without collision checks - these are done by the caller (second phase of simultaneous moves);
+    // returns true when apple was eaten - new apples are not added
+    bool advance(Direction direction)
+    {
+        direction_ = update_direction(direction);
+
+        return advance_to(new_segment_from(segments_.front(), direction_));
+    }
+
+    // segments are replaced - the current ones are taken off the board first, so only their cells are touched
+    void restore(std::span<const Point> segments, Direction direction, bool is_alive)
+    {
+        for (const auto& segment : segments_)
+            board_.remove_snake_segment(segment);
+
+        segments_.clear();
+        segments_.reserve(segments.size());
+        for (const auto& segment : segments)
+            segments_.push_back(segment);
+
+        direction_ = direction;
+        is_alive_ = is_alive;
+        place_on_board();
+    }
+
+    // snake is killed & its body is taken off the board
+    void remove_from_board()
+    {
+        is_alive_ = false;
+
+        for (const auto& segment : segments_)
+            board_.remove_snake_segment(segment);
+    }
+
+    bool operator==(const BasicSnake&) const = default;
 private:   
+    void place_on_board()
+    {
+        for (const auto& segment : segments_)
+            board_.place_snake_segment(segment);
+    }
+
+    bool advance_to(const Point& new_head)
+    {
+        segments_.push_front(new_head);
+        board_.place_snake_segment(new_head);
+
+        if (board_.try_eat_apple(new_head))
+            return true;
+
+        board_.remove_snake_segment(segments_.back());
+        segments_.pop_back();
+        return false;
+    }
+
     Direction update_direction(Direction new_direction) const
     {
         if (new_direction == opposite_direction(direction_))
@@ -187,7 +698,7 @@ private:
         return new_direction;
     }
 
-    Point new_segment_from(Point old, Direction direction)
+    Point new_segment_from(Point old, Direction direction) const
     {
         Point new_segment{};
         switch (direction)
@@ -228,51 +739,128 @@ private:
 
     bool is_eating_itself(const Point& new_head) const
     {
-        return std::ranges::find(segments_, new_head) != segments_.end();
+        return board_.has_snake_segment(new_head);
     }
 };
 
+// snake on a runtime-sized board
+using Snake = BasicSnake<Board>;
+
 class TerminalParam;
 class SnakeParam;
 
 template <typename TTerminal = class TerminalParam, typename TSnake = SnakeParam>
 class SnakeGame
 {
+public:
     enum class GameState { Menu, Playing, GameOver };
 
+    // state of the game itself - board & snake are kept separately
+    struct State
+    {
+        GameState game_state;
+        std::optional<Key> key_pressed;
+        Direction direction;
+
+        bool operator==(const State&) const = default;
+    };
+
+private:
     TTerminal& terminal_;
     TSnake& snake_;
     Board& board_;
     GameState game_state_{GameState::Menu};
     std::optional<Key> key_pressed_ = std::nullopt;
     Direction direction_{Direction::Up};
+    std::function<void(const Board&, const TSnake&)> tick_observer_;
 
 public:
     explicit SnakeGame(TTerminal& terminal, TSnake& snake, Board& board) : terminal_{terminal}, snake_{snake}, board_{board}
     {}
+
+    State state() const
+    {
+        return State{game_state_, key_pressed_, direction_};
+    }
+
+    void restore(const State& state)
+    {
+        game_state_ = state.game_state;
+        key_pressed_ = state.key_pressed;
+        direction_ = state.direction;
+    }
+
+    // called after every move of the snake - e.g. with SpectatorPublisher::publish
+    void on_tick(std::function<void(const Board&, const TSnake&)> observer)
+    {
+        tick_observer_ = std::move(observer);
+    }
     
     void run()
     {
         while(true)
         {
-            key_pressed_ = terminal_.read_key();
+            if (!timed(FramePhase::ReadKey, [this] { return process_input(); }))
+                return;
 
-            if (key_pressed_ == Key::Q)
-                    return;
+            timed(FramePhase::Clear, [this] { clear(); });
 
-            if (key_pressed_ == Key::P)
-                game_state_ = GameState::Playing;
+            timed(FramePhase::Update, [this] { update(); });
 
-            clear();
+            timed(FramePhase::Render, [this] { render(); });
 
-            update();
+            timed(FramePhase::Flush, [this] { flush(); });
+        }
+    }
 
-            render();
+    // fixed simulation step with independent rendering - paced by scheduler (e.g. FixedTimestepScheduler)
+    template <typename TScheduler>
+    void run(TScheduler& scheduler)
+    {
+        while(true)
+        {
+            auto frame = scheduler.wait_for_next_frame();
 
-            flush();
+            for (size_t i = 0; i < frame.updates; ++i)
+            {
+                if (!timed(FramePhase::ReadKey, [this] { return process_input(); }))
+                    return;
+
+                timed(FramePhase::Update, [this] { update(); });
+            }
+
+            if (frame.render)
+            {
+                timed(FramePhase::Clear, [this] { clear(); });
+
+                timed(FramePhase::Render, [this] { render(); });
+
+                timed(FramePhase::Flush, [this] { flush(); });
+            }
         }
     }
 private:
+    // phase is measured only with SNAKE_FRAME_TIMING - otherwise this is a plain call
+    template <typename TPhase>
+    decltype(auto) timed(FramePhase phase, TPhase&& run_phase)
+    {
+        [[maybe_unused]] PhaseTimer<> timer{phase};
+        return run_phase();
+    }
+
+    bool process_input()
+    {
+        key_pressed_ = terminal_.read_key();
+
+        if (key_pressed_ == Key::Q)
+            return false;
+
+        if (key_pressed_ == Key::P)
+            game_state_ = GameState::Playing;
+
+        return true;
+    }
+
     void clear()
     {
         terminal_.clear();
@@ -290,6 +878,9 @@ private:
             {
                 game_state_ = GameState::GameOver;            
             }        
+
+            if (tick_observer_)
+                tick_observer_(board_, snake_);
         }
     }
 
@@ -0,0 +1,151 @@
+#ifndef SNAKE_SWARM_HPP
+#define SNAKE_SWARM_HPP
+
+#include "snake/chunked_workers.hpp"
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Many snakes on a shared board moving simultaneously. Each step has two phases:
+//  1. every snake proposes its next head in parallel - walls & bodies are checked against the board's
+//     occupancy grid (read only, tails included just like Snake::move);
+//  2. heads claiming the same cell are found with a spatial hash - all of them die; the rest is applied
+//     in order of snakes, dead bodies are taken off the board & new apples are added at the end,
+//     so the result does not depend on number of threads.
+class SnakeSwarm
+{
+    enum class Outcome : uint8_t
+    {
+        Idle, // snake was dead before the step
+        Moves,
+        Dies
+    };
+
+    static constexpr uint64_t no_claim = UINT64_MAX;
+
+    Board& board_;
+    std::vector<Snake> snakes_;
+    std::vector<Point> next_heads_;
+    std::vector<Outcome> outcomes_;
+    std::vector<uint64_t> claimed_cells_; // spatial hash of next heads - open addressing, linear probing
+    std::vector<uint32_t> claims_;
+    ChunkedWorkers workers_;
+
+public:
+    explicit SnakeSwarm(Board& board, size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        : board_{board}, workers_{thread_count}
+    {}
+
+    // snake is placed on the board immediately; returns its index
+    size_t add_snake(Point head, Direction direction)
+    {
+        snakes_.emplace_back(board_, head, direction);
+        next_heads_.push_back(head);
+        outcomes_.push_back(Outcome::Idle);
+
+        return snakes_.size() - 1;
+    }
+
+    size_t size() const
+    {
+        return snakes_.size();
+    }
+
+    const Snake& snake(size_t index) const
+    {
+        return snakes_[index];
+    }
+
+    size_t alive_count() const
+    {
+        return static_cast<size_t>(std::ranges::count_if(snakes_, &Snake::is_alive));
+    }
+
+    void step(std::span<const Direction> directions)
+    {
+        if (directions.size() != snakes_.size())
+            throw std::invalid_argument("One direction per snake is required");
+
+        auto propose = [this, directions](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+                propose_move(i, directions[i]);
+        };
+        workers_.run(snakes_.size(), propose);
+
+        resolve_head_collisions();
+
+        size_t eaten_apples = 0;
+        for (size_t i = 0; i < snakes_.size(); ++i)
+        {
+            if (outcomes_[i] == Outcome::Moves && snakes_[i].advance(directions[i]))
+                ++eaten_apples;
+        }
+
+        for (size_t i = 0; i < snakes_.size(); ++i)
+        {
+            if (outcomes_[i] == Outcome::Dies)
+                snakes_[i].remove_from_board();
+        }
+
+        for (size_t i = 0; i < 2 * eaten_apples; ++i)
+            board_.add_apple();
+    }
+
+private:
+    void propose_move(size_t index, Direction direction)
+    {
+        const Snake& snake = snakes_[index];
+
+        if (!snake.is_alive())
+        {
+            outcomes_[index] = Outcome::Idle;
+            return;
+        }
+
+        const Point next_head = snake.next_head(direction);
+        next_heads_[index] = next_head;
+        outcomes_[index] = board_.is_hitting_walls(next_head) || board_.has_snake_segment(next_head)
+            ? Outcome::Dies
+            : Outcome::Moves;
+    }
+
+    void resolve_head_collisions()
+    {
+        const size_t capacity = std::bit_ceil(2 * snakes_.size());
+        claimed_cells_.assign(capacity, no_claim);
+        claims_.assign(capacity, 0);
+
+        for (size_t i = 0; i < snakes_.size(); ++i)
+        {
+            if (outcomes_[i] == Outcome::Moves)
+                ++claims_[claim_slot(next_heads_[i])];
+        }
+
+        for (size_t i = 0; i < snakes_.size(); ++i)
+        {
+            if (outcomes_[i] == Outcome::Moves && claims_[claim_slot(next_heads_[i])] > 1)
+                outcomes_[i] = Outcome::Dies;
+        }
+    }
+
+    size_t claim_slot(const Point& pt)
+    {
+        const uint64_t key = cell_key(pt.x, pt.y);
+        const size_t mask = claimed_cells_.size() - 1;
+
+        size_t slot = CellKeyHash{}(key) & mask;
+        while (claimed_cells_[slot] != no_claim && claimed_cells_[slot] != key)
+            slot = (slot + 1) & mask;
+
+        claimed_cells_[slot] = key;
+        return slot;
+    }
+};
+
+#endif // SNAKE_SWARM_HPP
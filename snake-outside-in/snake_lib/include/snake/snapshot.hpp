@@ -0,0 +1,218 @@
+#ifndef SNAKE_SNAPSHOT_HPP
+#define SNAKE_SNAPSHOT_HPP
+
+#include "snake/random.hpp"
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Binary image of Board + Snake (+ SnakeGame) state in native layout - meant for rewinding & lookahead
+// within a process, not for files (see Replay). The buffer is reused, so after the first snapshot of
+// similar size neither saving nor restoring allocates.
+// Random generator state is captured only for SeededRandomGenerator - other generators are left as they are.
+class Snapshot
+{
+    std::vector<uint8_t> bytes_;
+
+public:
+    explicit Snapshot(size_t capacity = 0)
+    {
+        bytes_.reserve(capacity);
+    }
+
+    size_t size() const
+    {
+        return bytes_.size();
+    }
+
+    bool empty() const
+    {
+        return bytes_.empty();
+    }
+
+    void save(const Board& board, const Snake& snake)
+    {
+        bytes_.clear();
+        save_board_and_snake(board, snake);
+        write(uint8_t{0});
+    }
+
+    template <typename TGame>
+    void save(const Board& board, const Snake& snake, const TGame& game)
+    {
+        bytes_.clear();
+        save_board_and_snake(board, snake);
+        write(uint8_t{1});
+        write(game.state());
+    }
+
+    void restore(Board& board, Snake& snake) const
+    {
+        size_t pos = 0;
+        restore_board_and_snake(board, snake, pos);
+    }
+
+    template <typename TGame>
+    void restore(Board& board, Snake& snake, TGame& game) const
+    {
+        size_t pos = 0;
+        restore_board_and_snake(board, snake, pos);
+
+        if (read<uint8_t>(pos))
+            game.restore(read<typename TGame::State>(pos));
+    }
+
+private:
+    void save_board_and_snake(const Board& board, const Snake& snake)
+    {
+        write(board.apples_revision());
+        write_points(board.apples());
+
+        const auto* rnd = board.rnd_generator_.target<SeededRandomGenerator>();
+        write(static_cast<uint8_t>(rnd != nullptr));
+        if (rnd)
+            write(*rnd);
+
+        write(snake.direction());
+        write(static_cast<uint8_t>(snake.is_alive()));
+
+        auto [first, second] = snake.segments().as_spans();
+        write(static_cast<uint32_t>(first.size() + second.size()));
+        bytes_.resize(aligned(bytes_.size()));
+        write_span(first);
+        write_span(second);
+    }
+
+    void restore_board_and_snake(Board& board, Snake& snake, size_t& pos) const
+    {
+        if (bytes_.empty())
+            throw std::logic_error("Snapshot is empty");
+
+        const auto apples_revision = read<uint64_t>(pos);
+        board.restore(read_points(pos), apples_revision);
+
+        if (read<uint8_t>(pos))
+        {
+            if (auto* target = board.rnd_generator_.target<SeededRandomGenerator>())
+                std::memcpy(static_cast<void*>(target), bytes_.data() + pos, sizeof(SeededRandomGenerator));
+            pos += sizeof(SeededRandomGenerator);
+        }
+
+        const auto direction = read<Direction>(pos);
+        const bool is_alive = read<uint8_t>(pos) != 0;
+        snake.restore(read_points(pos), direction, is_alive);
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const size_t pos = bytes_.size();
+        bytes_.resize(pos + sizeof(T));
+        std::memcpy(bytes_.data() + pos, &value, sizeof(T));
+    }
+
+    void write_span(std::span<const Point> points)
+    {
+        const size_t pos = bytes_.size();
+        bytes_.resize(pos + points.size_bytes());
+        if (!points.empty())
+            std::memcpy(bytes_.data() + pos, points.data(), points.size_bytes());
+    }
+
+    void write_points(std::span<const Point> points)
+    {
+        write(static_cast<uint32_t>(points.size()));
+        bytes_.resize(aligned(bytes_.size()));
+        write_span(points);
+    }
+
+    static size_t aligned(size_t pos)
+    {
+        return (pos + alignof(Point) - 1) / alignof(Point) * alignof(Point);
+    }
+
+    template <typename T>
+    T read(size_t& pos) const
+    {
+        T value;
+        std::memcpy(&value, bytes_.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    // points are read in place - they are aligned within the buffer (allocated by operator new)
+    std::span<const Point> read_points(size_t& pos) const
+    {
+        const auto count = read<uint32_t>(pos);
+        pos = aligned(pos);
+        std::span<const Point> points{reinterpret_cast<const Point*>(bytes_.data() + pos), count};
+        pos += points.size_bytes();
+        return points;
+    }
+};
+
+// The last N snapshots (e.g. one per tick) in preallocated slots - saving overwrites the oldest one
+class RollbackRing
+{
+    std::vector<Snapshot> snapshots_;
+    size_t next_{0};
+    size_t size_{0};
+
+public:
+    explicit RollbackRing(size_t capacity, size_t snapshot_capacity = 1024)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("Capacity must be positive");
+
+        snapshots_.reserve(capacity);
+        for (size_t i = 0; i < capacity; ++i)
+            snapshots_.emplace_back(snapshot_capacity);
+    }
+
+    size_t capacity() const
+    {
+        return snapshots_.size();
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    template <typename... TGame>
+    void save(const Board& board, const Snake& snake, const TGame&... game)
+    {
+        snapshots_[next_].save(board, snake, game...);
+        next_ = (next_ + 1) % snapshots_.size();
+        size_ = std::min(size_ + 1, snapshots_.size());
+    }
+
+    // 0 - the latest snapshot
+    const Snapshot& back(size_t ticks = 0) const
+    {
+        if (ticks >= size_)
+            throw std::out_of_range("Not enough snapshots");
+
+        return snapshots_[(next_ + snapshots_.size() - 1 - ticks) % snapshots_.size()];
+    }
+
+    // state from `ticks` snapshots back is restored; newer snapshots are dropped
+    template <typename... TGame>
+    void rewind(size_t ticks, Board& board, Snake& snake, TGame&... game)
+    {
+        back(ticks).restore(board, snake, game...);
+
+        next_ = (next_ + snapshots_.size() - ticks) % snapshots_.size();
+        size_ -= ticks;
+    }
+};
+
+#endif // SNAKE_SNAPSHOT_HPP
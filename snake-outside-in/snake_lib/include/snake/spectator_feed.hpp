@@ -0,0 +1,322 @@
+#ifndef SNAKE_SPECTATOR_FEED_HPP
+#define SNAKE_SPECTATOR_FEED_HPP
+
+#include "snake/snake.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// State of one tick as seen by spectators
+struct SpectatorFrame
+{
+    uint64_t tick{0};
+    int width{0};
+    int height{0};
+    Direction direction{Direction::Up};
+    bool is_alive{false};
+    bool is_truncated{false}; // more segments & apples than a slot holds - the rest is missing
+    std::vector<Point> snake;
+    std::vector<Point> apples;
+};
+
+// Ring of tick slots in POSIX shared memory, shared by SpectatorPublisher & SpectatorReader.
+// Memory is a sequence of 64-bit atomic words:
+//  header: magic, slot count, payload words per slot, number of published ticks
+//  slot:   sequence (odd while being written), tick, width & height, direction & flags,
+//          snake & apple counts, one word per point (snake head first, then apples)
+// Every slot is a seqlock - the publisher never waits; a reader retries when the sequence moved under it.
+class SpectatorFeed
+{
+protected:
+    using Word = std::atomic<uint64_t>;
+    static_assert(Word::is_always_lock_free && sizeof(Word) == sizeof(uint64_t));
+
+    static constexpr uint64_t magic = 0x534E414B45464431; // "SNAKEFD1"
+    static constexpr size_t header_words = 4;
+    static constexpr size_t frame_header_words = 4;
+
+    enum HeaderWord : size_t { Magic, SlotCount, SlotWords, Published };
+
+    Word* words_{nullptr};
+    size_t size_{0};
+
+    SpectatorFeed() = default;
+
+    ~SpectatorFeed()
+    {
+        if (words_)
+            munmap(words_, size_);
+    }
+
+    SpectatorFeed(const SpectatorFeed&) = delete;
+    SpectatorFeed& operator=(const SpectatorFeed&) = delete;
+
+    // shared memory is zero filled - atomics of lock free integers are used in place
+    void map(int fd, size_t size, int protection)
+    {
+        void* memory = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (memory == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap");
+
+        words_ = static_cast<Word*>(memory);
+        size_ = size;
+    }
+
+    static size_t feed_size(uint64_t slot_count, uint64_t slot_words)
+    {
+        return (header_words + slot_count * (1 + slot_words)) * sizeof(Word);
+    }
+
+    Word& header(HeaderWord word) const
+    {
+        return words_[word];
+    }
+
+    Word* slot(uint64_t tick) const
+    {
+        const uint64_t slot_count = header(SlotCount).load(std::memory_order_relaxed);
+        const uint64_t slot_words = header(SlotWords).load(std::memory_order_relaxed);
+        return words_ + header_words + (tick % slot_count) * (1 + slot_words);
+    }
+
+    static uint64_t pack(int a, int b)
+    {
+        return uint64_t{static_cast<uint32_t>(a)} << 32 | static_cast<uint32_t>(b);
+    }
+
+    static std::pair<int, int> unpack(uint64_t word)
+    {
+        return {static_cast<int32_t>(word >> 32), static_cast<int32_t>(word & UINT32_MAX)};
+    }
+
+public:
+    uint64_t published() const
+    {
+        return header(Published).load(std::memory_order_acquire);
+    }
+
+    uint64_t slot_count() const
+    {
+        return header(SlotCount).load(std::memory_order_relaxed);
+    }
+};
+
+// Creates the feed (e.g. "/snake") & writes one frame per tick - called from the game thread
+class SpectatorPublisher : public SpectatorFeed
+{
+    std::string name_;
+    uint64_t max_points_;
+
+public:
+    explicit SpectatorPublisher(std::string name, size_t slot_count = 64, size_t max_points = 4096)
+        : name_{std::move(name)}, max_points_{max_points}
+    {
+        if (slot_count == 0)
+            throw std::invalid_argument("Slot count must be positive");
+
+        const uint64_t slot_words = frame_header_words + max_points;
+        const size_t size = feed_size(slot_count, slot_words);
+
+        // a live feed of the same name is never taken over - its readers would lose the mapped memory (SIGBUS);
+        // a feed left by a crashed publisher has to be removed first (e.g. rm /dev/shm/<name>)
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd == -1)
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+
+        if (ftruncate(fd, static_cast<off_t>(size)) == -1)
+        {
+            const int error = errno;
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + name_);
+        }
+
+        try
+        {
+            map(fd, size, PROT_READ | PROT_WRITE);
+        }
+        catch (...)
+        {
+            shm_unlink(name_.c_str());
+            throw;
+        }
+
+        header(SlotCount).store(slot_count, std::memory_order_relaxed);
+        header(SlotWords).store(slot_words, std::memory_order_relaxed);
+        header(Magic).store(magic, std::memory_order_release);
+    }
+
+    ~SpectatorPublisher()
+    {
+        shm_unlink(name_.c_str());
+    }
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    template <typename TSnake>
+    void publish(const Board& board, const TSnake& snake)
+    {
+        const uint64_t tick = header(Published).load(std::memory_order_relaxed);
+        Word* slot_words = slot(tick);
+        Word& sequence = slot_words[0];
+        Word* payload = slot_words + 1;
+
+        const uint64_t version = sequence.load(std::memory_order_relaxed);
+        sequence.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const uint64_t snake_count = std::min<uint64_t>(snake.segments().size(), max_points_);
+        const uint64_t apple_count = std::min<uint64_t>(board.apples().size(), max_points_ - snake_count);
+        const bool is_truncated = snake_count + apple_count < snake.segments().size() + board.apples().size();
+
+        payload[0].store(tick, std::memory_order_relaxed);
+        payload[1].store(pack(board.width(), board.height()), std::memory_order_relaxed);
+        payload[2].store(static_cast<uint64_t>(snake.direction()) | uint64_t{snake.is_alive()} << 8
+                | uint64_t{is_truncated} << 9,
+            std::memory_order_relaxed);
+        payload[3].store(snake_count << 32 | apple_count, std::memory_order_relaxed);
+
+        Word* point = payload + frame_header_words;
+        for (const auto& segment : snake.segments())
+        {
+            if (point == payload + frame_header_words + snake_count)
+                break;
+            (point++)->store(pack(segment.x, segment.y), std::memory_order_relaxed);
+        }
+
+        for (uint64_t i = 0; i < apple_count; ++i)
+            (point++)->store(pack(board.apples()[i].x, board.apples()[i].y), std::memory_order_relaxed);
+
+        sequence.store(version + 2, std::memory_order_release);
+        header(Published).store(tick + 1, std::memory_order_release);
+    }
+};
+
+// Opens an existing feed read only - frames are copied out & validated by slot sequence, so they are never torn
+class SpectatorReader : public SpectatorFeed
+{
+    static constexpr int max_attempts = 1000;
+
+    mutable std::vector<uint64_t> words_read_;
+
+public:
+    explicit SpectatorReader(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd == -1)
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+
+        struct stat status{};
+        if (fstat(fd, &status) == -1 || static_cast<size_t>(status.st_size) < header_words * sizeof(Word))
+        {
+            close(fd);
+            throw std::runtime_error("Spectator feed " + name + " is not ready");
+        }
+
+        map(fd, static_cast<size_t>(status.st_size), PROT_READ);
+
+        if (header(Magic).load(std::memory_order_acquire) != magic
+            || feed_size(header(SlotCount).load(std::memory_order_relaxed),
+                   header(SlotWords).load(std::memory_order_relaxed)) > size_)
+            throw std::runtime_error("Spectator feed " + name + " is not ready");
+    }
+
+    // false when nothing was published yet
+    bool read_latest(SpectatorFrame& frame) const
+    {
+        for (int attempt = 0; attempt < max_attempts; ++attempt)
+        {
+            const uint64_t published_ticks = published();
+            if (published_ticks == 0)
+                return false;
+
+            if (read(published_ticks - 1, frame))
+                return true;
+        }
+
+        return false;
+    }
+
+    // false when the tick was not published yet or its slot was already reused
+    bool read(uint64_t tick, SpectatorFrame& frame) const
+    {
+        const Word* slot_words = slot(tick);
+        const Word& sequence = slot_words[0];
+        const Word* payload = slot_words + 1;
+        const uint64_t max_points = header(SlotWords).load(std::memory_order_relaxed) - frame_header_words;
+
+        for (int attempt = 0; attempt < max_attempts; ++attempt)
+        {
+            const uint64_t version = sequence.load(std::memory_order_acquire);
+            if (version % 2 == 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            words_read_.resize(frame_header_words);
+            for (size_t i = 0; i < frame_header_words; ++i)
+                words_read_[i] = payload[i].load(std::memory_order_relaxed);
+
+            // counts may be garbage when torn - they are clamped & the copy is discarded below
+            const uint64_t point_count = std::min(max_points, (words_read_[3] >> 32) + (words_read_[3] & UINT32_MAX));
+            words_read_.resize(frame_header_words + point_count);
+            for (size_t i = frame_header_words; i < words_read_.size(); ++i)
+                words_read_[i] = payload[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != version)
+                continue;
+
+            if (version == 0 || words_read_[0] != tick)
+                return false;
+
+            decode(frame);
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    void decode(SpectatorFrame& frame) const
+    {
+        frame.tick = words_read_[0];
+        std::tie(frame.width, frame.height) = unpack(words_read_[1]);
+        frame.direction = static_cast<Direction>(words_read_[2] & 0xFF);
+        frame.is_alive = (words_read_[2] >> 8) & 1;
+        frame.is_truncated = (words_read_[2] >> 9) & 1;
+
+        const uint64_t snake_count = words_read_[3] >> 32;
+
+        frame.snake.clear();
+        frame.apples.clear();
+        for (size_t i = frame_header_words; i < words_read_.size(); ++i)
+        {
+            const auto [x, y] = unpack(words_read_[i]);
+            auto& points = i - frame_header_words < snake_count ? frame.snake : frame.apples;
+            points.push_back(Point{x, y});
+        }
+    }
+};
+
+#endif // SNAKE_SPECTATOR_FEED_HPP
@@ -0,0 +1,212 @@
+#ifndef SNAKE_STATIC_BOARD_HPP
+#define SNAKE_STATIC_BOARD_HPP
+
+#include "snake/snake.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Board with dimensions known at compile time (e.g. 20x10 or 40x30) - interface of Board, but walls, apples
+// & snake are kept in bitboards (bit per cell, walls included), so wall, collision & apple tests are single bit
+// tests and a random free cell is picked with a few popcounts. Used with BasicSnake<StaticBoard<W, H>>.
+template <int Width, int Height>
+class StaticBoard
+{
+    static_assert(Width >= 2 && Height >= 2);
+
+    static constexpr size_t stride = static_cast<size_t>(Width) + 1;
+    static constexpr size_t cell_count = stride * (static_cast<size_t>(Height) + 1);
+    static constexpr size_t word_count = (cell_count + 63) / 64;
+
+    using Bitboard = std::array<uint64_t, word_count>;
+
+    Bitboard walls_{make_walls()}; // bits past the last cell are set as walls - they are never free
+    Bitboard apples_{};
+    Bitboard snake_{};
+    std::vector<Point> apple_list_;
+    std::array<uint32_t, cell_count> apple_positions_{}; // position of apple in apple_list_
+    uint64_t apples_revision_{0};
+    IRandomGenerator rnd_generator_;
+
+public:
+    explicit StaticBoard(size_t apple_count = 0, IRandomGenerator rnd_gen = RandomGenerator)
+        : rnd_generator_{rnd_gen}
+    {
+        for (size_t i = 0; i < apple_count; ++i)
+        {
+            add_apple();
+        }
+    }
+
+    static constexpr int width()
+    {
+        return Width;
+    }
+
+    static constexpr int height()
+    {
+        return Height;
+    }
+
+    const std::vector<Point>& apples() const
+    {
+        return apple_list_;
+    }
+
+    uint64_t apples_revision() const
+    {
+        return apples_revision_;
+    }
+
+    bool has_apple(const Point& apple) const
+    {
+        return is_on_board(apple) && test(apples_, index_of(apple));
+    }
+
+    // apple is placed on a random empty cell - same distribution as Board::add_apple()
+    void add_apple()
+    {
+        auto apple = random_empty_cell();
+        if (!apple)
+            return;
+
+        const size_t index = index_of(*apple);
+        apple_positions_[index] = static_cast<uint32_t>(apple_list_.size());
+        apple_list_.push_back(*apple);
+        set(apples_, index);
+        ++apples_revision_;
+    }
+
+    bool try_eat_apple(const Point& point)
+    {
+        if (!has_apple(point))
+            return false;
+
+        const size_t index = index_of(point);
+        const uint32_t position = apple_positions_[index];
+
+        apple_list_[position] = apple_list_.back();
+        apple_positions_[index_of(apple_list_[position])] = position;
+        apple_list_.pop_back();
+        reset(apples_, index);
+
+        ++apples_revision_;
+        return true;
+    }
+
+    size_t free_cell_count() const
+    {
+        size_t count = 0;
+        for (size_t word = 0; word < word_count; ++word)
+            count += static_cast<size_t>(std::popcount(free_word(word)));
+        return count;
+    }
+
+    bool has_snake_segment(const Point& point) const
+    {
+        return is_on_board(point) && test(snake_, index_of(point));
+    }
+
+    void place_snake_segment(const Point& point)
+    {
+        if (is_on_board(point))
+            set(snake_, index_of(point));
+    }
+
+    void remove_snake_segment(const Point& point)
+    {
+        if (is_on_board(point))
+            reset(snake_, index_of(point));
+    }
+
+    bool is_hitting_walls(const Point& point) const
+    {
+        return !is_on_board(point) || test(walls_, index_of(point));
+    }
+
+private:
+    static constexpr Bitboard make_walls()
+    {
+        Bitboard walls{};
+
+        for (size_t index = 0; index < word_count * 64; ++index)
+        {
+            const size_t x = index % stride;
+            const size_t y = index / stride;
+
+            if (index >= cell_count || x == 0 || x == Width || y == 0 || y == Height)
+                walls[index / 64] |= uint64_t{1} << (index % 64);
+        }
+
+        return walls;
+    }
+
+    static bool is_on_board(const Point& point)
+    {
+        return static_cast<unsigned>(point.x) <= static_cast<unsigned>(Width)
+            && static_cast<unsigned>(point.y) <= static_cast<unsigned>(Height);
+    }
+
+    static size_t index_of(const Point& point)
+    {
+        return static_cast<size_t>(point.y) * stride + static_cast<size_t>(point.x);
+    }
+
+    static bool test(const Bitboard& bits, size_t index)
+    {
+        return (bits[index / 64] >> (index % 64)) & 1u;
+    }
+
+    static void set(Bitboard& bits, size_t index)
+    {
+        bits[index / 64] |= uint64_t{1} << (index % 64);
+    }
+
+    static void reset(Bitboard& bits, size_t index)
+    {
+        bits[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+
+    uint64_t free_word(size_t word) const
+    {
+        return ~(walls_[word] | apples_[word] | snake_[word]);
+    }
+
+    std::optional<Point> random_empty_cell()
+    {
+        Point cell{rnd_generator_(1, Width - 1), rnd_generator_(1, Height - 1)};
+        if (!test(apples_, index_of(cell)) && !test(snake_, index_of(cell)))
+            return cell;
+
+        const size_t free_cells = free_cell_count();
+        if (free_cells == 0)
+            return std::nullopt;
+
+        // n-th free bit: skip whole words by popcount, then clear lower bits in the word
+        auto nth = static_cast<size_t>(rnd_generator_(0, static_cast<int>(free_cells) - 1));
+        for (size_t word = 0; word < word_count; ++word)
+        {
+            uint64_t bits = free_word(word);
+            const auto count = static_cast<size_t>(std::popcount(bits));
+
+            if (nth >= count)
+            {
+                nth -= count;
+                continue;
+            }
+
+            for (; nth > 0; --nth)
+                bits &= bits - 1;
+
+            const size_t index = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+            return Point{static_cast<int>(index % stride), static_cast<int>(index / stride)};
+        }
+
+        return std::nullopt;
+    }
+};
+
+#endif // SNAKE_STATIC_BOARD_HPP
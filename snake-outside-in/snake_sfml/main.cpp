@@ -1,5 +1,7 @@
 #include "sfml_terminal.hpp"
 #include <snake/snake.hpp>
+#include <snake/frame_scheduler.hpp>
+#include <snake/frame_timing.hpp>
 
 #include <boost/di.hpp>
 
@@ -47,7 +49,13 @@ int main()
     );
 
     auto game = injector.create<SnakeGame>();
-    game.run();
+
+    using namespace std::chrono_literals;
+    FixedTimestepScheduler scheduler{75ms, 16ms};
+    game.run(scheduler);
+
+    if constexpr (frame_timing_enabled)
+        frame_timings().dump(std::cout);
 
     /////////////////
     // hand-wired
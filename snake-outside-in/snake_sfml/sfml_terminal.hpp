@@ -1,27 +1,53 @@
 #ifndef SFML_TERMINAL_HPP
 #define SFML_TERMINAL_HPP
 
-#include <snake/snake.hpp>
+#include <snake/frame_timing.hpp>
+#include <snake/key_queue.hpp>
 #include <snake/snake.hpp>
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <format>
+#include <iostream>
+#include <numbers>
+#include <utility>
 
 class SfmlTerminal 
 {
     int columns_, rows_;
     sf::RenderWindow window_;
     constexpr static size_t segment_size_ = 30;
-    Key key_;
+    constexpr static size_t apple_triangles_ = 12;
+    sf::VertexArray walls_{sf::Triangles};  // static layer - built once
+    sf::VertexArray sprites_{sf::Triangles}; // dynamic layer - snake & apples, rebuilt every frame
+    sf::Font font_;
+    bool board_rendered_{false};
+    size_t draw_calls_{0};
+    size_t frames_{0};
+    size_t total_draw_calls_{0};
+    KeyQueue<64> keys_;
+    bool close_requested_{false};
 
 public:
     SfmlTerminal(int columns, int rows)
         : columns_{columns}, rows_{rows}
         ,window_(sf::VideoMode((columns + 1) * segment_size_, (rows + 1) * segment_size_), "SFML Snake")
     {
+        window_.setKeyRepeatEnabled(false); // a held key is one press
+        font_.loadFromFile("ibm-vga-9x16.ttf");
+        build_walls();
     }
 
     ~SfmlTerminal()
     {
+        if (frames_ > 0)
+            std::cout << "Draw calls per frame: " << static_cast<double>(total_draw_calls_) / frames_ << std::endl;
+
+        if (keys_.latency().count() > 0)
+            std::cout << "Input to turn latency [ms]: p50 " << keys_.latency().percentile(0.5) / 1e6
+                      << ", p99 " << keys_.latency().percentile(0.99) / 1e6 << std::endl;
+
         sf::Event event;
         while (window_.pollEvent(event))
         {
@@ -31,64 +57,40 @@ public:
         }
     }
 
+    // one queued key per call (i.e. one turn per tick) - keys pressed between ticks wait for their turn in order
     std::optional<Key> read_key()
     {
-        sf::Event event;
-        window_.pollEvent(event);
-
-        if (event.type == sf::Event::Closed || sf::Keyboard::isKeyPressed(sf::Keyboard::Q))
-            key_ = Key::Q;        
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::P))
-            key_ = Key::P;
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
-            key_ = Key::ArrowLeft;
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
-            key_ = Key::ArrowRight;
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
-            key_ = Key::ArrowDown;
+        drain_events();
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-            key_ = Key::ArrowUp;
+        if (close_requested_)
+            return Key::Q;
 
-        return key_;
+        return keys_.pop();
     }
 
     void clear()
     {
         window_.clear();
+        sprites_.clear();
+        board_rendered_ = false;
+        draw_calls_ = 0;
     }
 
     void render_snake(const Snake& snake)
     {
         for(const auto& segment : snake.segments())
         {            
-            draw_rectangle(segment.x, segment.y, sf::Color::Green);
+            append_rectangle(segment.x, segment.y, sf::Color::Green);
         }
     }
 
     void render_board(const Board& board)
     {        
-        sf::Color gray(164, 164, 164);
-        for(int i = 0; i <= columns_; ++i)
-        {
-            draw_rectangle(i, 0, gray);
-            draw_rectangle(i, rows_, gray);
-        }
-
-        for(int i = 0; i <= rows_; ++i)
-        {
-            draw_rectangle(0, i, gray);
-            draw_rectangle(columns_, i, gray);
-        }
-        
+        board_rendered_ = true;
 
         for(const auto& apple : board.apples())
         {
-            draw_apple(apple.x, apple.y);
+            append_apple(apple.x, apple.y);
         }
     }
 
@@ -101,9 +103,7 @@ public:
             message += std::format("{:^25}\n", line);
         }
 
-        sf::Font font;
-        font.loadFromFile("ibm-vga-9x16.ttf");
-        sf::Text text(message, font);
+        sf::Text text(message, font_);
         text.setCharacterSize(50);
         text.setFillColor(sf::Color::White);
         auto text_bounds = text.getGlobalBounds();
@@ -112,29 +112,139 @@ public:
         const auto x_center = window_.getSize().x / 2;
         const auto y_center = window_.getSize().y / 2;
         text.setPosition(x_center - x_offset, y_center / 2 - y_offset);
-        window_.draw(text);
+        draw(text);
     }
 
+    // walls & sprites are drawn in two batched calls
     void flush()
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(75));
+        if (board_rendered_)
+            draw(walls_);
+
+        if (sprites_.getVertexCount() > 0)
+            draw(sprites_);
+
+        if constexpr (frame_timing_enabled)
+            draw_frame_timings();
+
         window_.display();
+
+        drain_events();
+
+        ++frames_;
+        total_draw_calls_ += draw_calls_;
+    }
+
+    size_t draw_calls() const
+    {
+        return draw_calls_;
     }
 private:
-    void draw_rectangle(size_t i, size_t j, sf::Color color)
+    // all pending events are taken every frame, so key presses are stamped close to the time they arrived
+    void drain_events()
     {
-        sf::RectangleShape rectangle(sf::Vector2f(segment_size_, segment_size_));
-        rectangle.setFillColor(color);
-        rectangle.setPosition(i * segment_size_, j * segment_size_);
-        window_.draw(rectangle);
+        constexpr std::array<std::pair<sf::Keyboard::Key, Key>, 6> key_map{{
+            {sf::Keyboard::Q, Key::Q},
+            {sf::Keyboard::P, Key::P},
+            {sf::Keyboard::Left, Key::ArrowLeft},
+            {sf::Keyboard::Right, Key::ArrowRight},
+            {sf::Keyboard::Down, Key::ArrowDown},
+            {sf::Keyboard::Up, Key::ArrowUp}
+        }};
+
+        sf::Event event;
+        while (window_.pollEvent(event))
+        {
+            if (event.type == sf::Event::Closed)
+                close_requested_ = true;
+
+            if (event.type != sf::Event::KeyPressed)
+                continue;
+
+            auto mapped = std::ranges::find(key_map, event.key.code, &std::pair<sf::Keyboard::Key, Key>::first);
+            if (mapped != key_map.end())
+                keys_.push(mapped->second);
+        }
+    }
+
+    // overlay with p50/p99 of frame phases (SNAKE_FRAME_TIMING builds only) - not counted as a draw call
+    void draw_frame_timings()
+    {
+        std::string overlay;
+        for (size_t i = 0; i < frame_phase_count; ++i)
+        {
+            const auto phase = static_cast<FramePhase>(i);
+            const auto& histogram = frame_timings().histogram(phase);
+            overlay += std::format("{:<9}{:>8.1f}{:>8.1f} us\n", to_string(phase),
+                histogram.percentile(0.5) / 1000.0, histogram.percentile(0.99) / 1000.0);
+        }
+
+        sf::Text text(overlay, font_);
+        text.setCharacterSize(16);
+        text.setFillColor(sf::Color::Yellow);
+        text.setPosition(segment_size_ + 4.0f, segment_size_ + 4.0f);
+        window_.draw(text);
+    }
+
+    void draw(const sf::Drawable& drawable)
+    {
+        window_.draw(drawable);
+        ++draw_calls_;
+    }
+
+    void build_walls()
+    {
+        sf::Color gray(164, 164, 164);
+        for(int i = 0; i <= columns_; ++i)
+        {
+            append_rectangle(walls_, i, 0, gray);
+            append_rectangle(walls_, i, rows_, gray);
+        }
+
+        for(int i = 0; i <= rows_; ++i)
+        {
+            append_rectangle(walls_, 0, i, gray);
+            append_rectangle(walls_, columns_, i, gray);
+        }
+    }
+
+    void append_rectangle(size_t i, size_t j, sf::Color color)
+    {
+        append_rectangle(sprites_, i, j, color);
+    }
+
+    static void append_rectangle(sf::VertexArray& vertices, size_t i, size_t j, sf::Color color)
+    {
+        const float left = i * segment_size_;
+        const float top = j * segment_size_;
+        const float right = left + segment_size_;
+        const float bottom = top + segment_size_;
+
+        vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(right, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color));
     }
 
-    void draw_apple(size_t i, size_t j)
+    // apple as a circle approximated with a fan of triangles
+    void append_apple(size_t i, size_t j)
     {
-        sf::CircleShape circle(segment_size_ / 2);
-        circle.setFillColor(sf::Color::Red);
-        circle.setPosition(i * segment_size_, j * segment_size_);
-        window_.draw(circle);
+        const float radius = segment_size_ / 2.0f;
+        const sf::Vector2f center(i * segment_size_ + radius, j * segment_size_ + radius);
+
+        auto point_on_circle = [&](size_t k) {
+            const float angle = 2.0f * std::numbers::pi_v<float> * k / apple_triangles_;
+            return sf::Vector2f(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+        };
+
+        for (size_t k = 0; k < apple_triangles_; ++k)
+        {
+            sprites_.append(sf::Vertex(center, sf::Color::Red));
+            sprites_.append(sf::Vertex(point_on_circle(k), sf::Color::Red));
+            sprites_.append(sf::Vertex(point_on_circle(k + 1), sf::Color::Red));
+        }
     }
 };
 
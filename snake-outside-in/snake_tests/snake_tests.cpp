@@ -1,11 +1,28 @@
 #include "snake/snake.hpp"
+#include "snake/autopilot.hpp"
+#include "snake/batch_simulation.hpp"
+#include "snake/frame_scheduler.hpp"
+#include "snake/frame_timing.hpp"
+#include "snake/key_queue.hpp"
+#include "snake/replay.hpp"
+#include "snake/rollout_bot.hpp"
+#include "snake/snake_swarm.hpp"
+#include "snake/snapshot.hpp"
+#include "snake/spectator_feed.hpp"
+#include "snake/static_board.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <boost/di.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
 #include <catch2/trompeloeil.hpp>
+#include <map>
 #include <ranges>
+#include <set>
+#include <sstream>
 #include <trompeloeil.hpp>
 
 using namespace std;
@@ -447,3 +464,1248 @@ TEST_CASE("Snake - eating apples from the board")
         }
     }    
 }
+
+TEST_CASE("Board - tracks cells occupied by snake", "[Board][Snake]")
+{
+    Board board{20, 10};
+
+    Snake snake{board, Point{5, 5}, Direction::Up};
+
+    SECTION("snake's segments are placed on the board")
+    {
+        REQUIRE(board.has_snake_segment(Point{5, 5}));
+        REQUIRE(board.has_snake_segment(Point{5, 6}));
+        REQUIRE_FALSE(board.has_snake_segment(Point{5, 4}));
+    }
+
+    SECTION("when snake moves")
+    {
+        snake.move(Direction::Up);
+
+        SECTION("new head is placed on the board")
+        {
+            REQUIRE(board.has_snake_segment(Point{5, 4}));
+        }
+
+        SECTION("tail is removed from the board")
+        {
+            REQUIRE_FALSE(board.has_snake_segment(Point{5, 6}));
+        }
+    }
+}
+
+TEST_CASE("Board - huge board is stored sparsely", "[Board]")
+{
+    Board board{100'000, 100'000, 10'000, SeededRandomGenerator{37}};
+
+    Snake snake{board, Point{99'990, 50'000}, Direction::Right};
+
+    SECTION("only tiles with apples or snake are allocated")
+    {
+        REQUIRE(board.occupancy_memory_usage() < (10'000 + 1) * 128);
+    }
+
+    SECTION("every apple can be found in O(1)")
+    {
+        REQUIRE(board.apples().size() == 10'000);
+        REQUIRE(std::ranges::all_of(board.apples(), [&](const Point& apple) { return board.has_apple(apple); }));
+    }
+
+    SECTION("apples are not placed on occupied cells")
+    {
+        std::set<std::pair<int, int>> cells;
+        for (const auto& apple : board.apples())
+            cells.emplace(apple.x, apple.y);
+
+        REQUIRE(cells.size() == board.apples().size());
+        REQUIRE_FALSE(std::ranges::any_of(board.apples(), [&](const Point& apple) { return board.has_snake_segment(apple); }));
+    }
+
+    SECTION("eaten apple is replaced by the last one")
+    {
+        const auto apples = board.apples();
+
+        REQUIRE(board.try_eat_apple(apples[0]));
+
+        REQUIRE(board.apples().size() == apples.size() - 1);
+        REQUIRE(board.apples()[0] == apples.back());
+        REQUIRE_FALSE(board.has_apple(apples[0]));
+        REQUIRE(board.has_apple(apples.back()));
+    }
+
+    SECTION("snake hits the far wall")
+    {
+        for (int i = 0; i < 9; ++i)
+            snake.move(Direction::Right);
+
+        REQUIRE(snake.is_alive());
+        REQUIRE(board.has_snake_segment(Point{99'999, 50'000}));
+
+        snake.move(Direction::Right);
+
+        REQUIRE_FALSE(snake.is_alive());
+    }
+}
+
+TEST_CASE("Board - regular board is stored densely", "[Board]")
+{
+    Board board{40, 30, 10, SeededRandomGenerator{5}};
+
+    REQUIRE(board.occupancy_memory_usage() < 41 * 31); // grid & free-cell index take under a byte per cell
+    REQUIRE(std::ranges::all_of(board.apples(), [&](const Point& apple) { return board.has_apple(apple); }));
+}
+
+TEST_CASE("Board - equality compares cells & apples only", "[Board]")
+{
+    Board board{10, 8, 0};
+    Board other_board{10, 8, 0};
+
+    // the same cells occupied in a different order
+    for (const auto& point : {Point{1, 1}, Point{2, 2}, Point{3, 3}})
+        board.place_snake_segment(point);
+    for (const auto& point : {Point{3, 3}, Point{1, 1}, Point{2, 2}})
+        other_board.place_snake_segment(point);
+
+    REQUIRE(board == other_board);
+
+    other_board.remove_snake_segment(Point{2, 2});
+
+    REQUIRE_FALSE(board == other_board);
+}
+
+TEST_CASE("OccupancyGrid - dense up to the threshold", "[Board]")
+{
+    OccupancyGrid grid{2048, 2048};
+    REQUIRE_FALSE(grid.is_sparse());
+
+    grid.add(Point{2047, 2047}, Cell::Snake);
+    grid.add(Point{2047, 2047}, Cell::Apple);
+    grid.remove(Point{2047, 2047}, Cell::Snake);
+
+    REQUIRE(grid.tile_count() == 0);
+    REQUIRE(grid.has(Point{2047, 2047}, Cell::Apple));
+    REQUIRE_FALSE(grid.has(Point{2047, 2047}, Cell::Snake));
+    REQUIRE(OccupancyGrid{2049, 2048}.is_sparse());
+}
+
+TEST_CASE("OccupancyGrid - tiles are allocated on demand", "[Board]")
+{
+    OccupancyGrid grid{100'000, 100'000};
+    REQUIRE(grid.is_sparse());
+    REQUIRE(grid.tile_count() == 0);
+
+    grid.add(Point{1, 1}, Cell::Snake);
+    grid.add(Point{2, 2}, Cell::Apple);
+    grid.add(Point{99'999, 99'999}, Cell::Apple);
+
+    REQUIRE(grid.tile_count() == 2);
+    REQUIRE(grid.has(Point{1, 1}, Cell::Snake));
+    REQUIRE_FALSE(grid.has(Point{1, 1}, Cell::Apple));
+    REQUIRE(grid.is_empty(Point{3, 3}));
+
+    SECTION("tile is released when its last cell is emptied")
+    {
+        grid.remove(Point{1, 1}, Cell::Snake);
+        REQUIRE(grid.tile_count() == 2);
+
+        grid.remove(Point{2, 2}, Cell::Apple);
+        REQUIRE(grid.tile_count() == 1);
+        REQUIRE(grid.is_empty(Point{2, 2}));
+    }
+}
+
+TEST_CASE("Board - apples are spawned on free cells", "[Board]")
+{
+    Board board{5, 4, 0, SeededRandomGenerator{39}}; // 4x3 inner cells
+    Snake snake{board, Point{2, 2}, Direction::Up};
+
+    REQUIRE(board.free_cell_count() == 12 - 2);
+
+    SECTION("free cells are tracked as snake moves")
+    {
+        snake.move(Direction::Right);
+
+        REQUIRE(board.free_cell_count() == 12 - 2);
+    }
+
+    SECTION("until the board is full")
+    {
+        for (int i = 0; i < 20; ++i)
+            board.add_apple();
+
+        REQUIRE(board.apples().size() == 10);
+        REQUIRE(board.free_cell_count() == 0);
+        REQUIRE_FALSE(std::ranges::any_of(board.apples(), [&](const Point& apple) { return board.has_snake_segment(apple); }));
+    }
+
+    SECTION("uniformly")
+    {
+        std::map<std::pair<int, int>, int> counts;
+
+        for (int i = 0; i < 20'000; ++i)
+        {
+            board.add_apple();
+            const Point apple = board.apples().back();
+            ++counts[{apple.x, apple.y}];
+            REQUIRE(board.try_eat_apple(apple));
+        }
+
+        REQUIRE(counts.size() == 10);
+        REQUIRE(std::ranges::all_of(counts, [](const auto& count) { return count.second > 1'800 && count.second < 2'200; }));
+    }
+}
+
+TEST_CASE("StaticBoard - walls, apples & snake in bitboards", "[StaticBoard]")
+{
+    auto stub_rnd = [seed = 20](int, int) mutable {
+        return seed--;
+    };
+
+    StaticBoard<40, 30> board{1, stub_rnd};
+    BasicSnake snake{board, Point{20, 20}, Direction::Up};
+
+    SECTION("walls surround inner cells")
+    {
+        auto [point, is_wall] = GENERATE(table<Point, bool>({
+            {Point{0, 5}, true}, {Point{40, 5}, true}, {Point{5, 0}, true}, {Point{5, 30}, true},
+            {Point{-1, 5}, true}, {Point{5, 100}, true}, {Point{1, 1}, false}, {Point{39, 29}, false}}));
+
+        REQUIRE(board.is_hitting_walls(point) == is_wall);
+    }
+
+    SECTION("snake eats apple & grows")
+    {
+        REQUIRE(board.apples() == std::vector{Point{20, 19}});
+
+        snake.move(Direction::Up);
+
+        REQUIRE(snake.segments() == std::vector{Point{20, 19}, Point{20, 20}, Point{20, 21}});
+        REQUIRE_FALSE(board.has_apple(Point{20, 19}));
+        REQUIRE(board.apples() == std::vector{Point{18, 17}, Point{16, 15}});
+    }
+
+    SECTION("snake's cells are tracked as it moves")
+    {
+        snake.move(Direction::Left);
+
+        REQUIRE(board.has_snake_segment(Point{19, 20}));
+        REQUIRE(board.has_snake_segment(Point{20, 20}));
+        REQUIRE_FALSE(board.has_snake_segment(Point{20, 21}));
+        REQUIRE(board.free_cell_count() == 39 * 29 - 2 - 1);
+    }
+
+    SECTION("snake dies hitting the wall")
+    {
+        for (int i = 0; i < 19; ++i)
+            snake.move(Direction::Right);
+
+        REQUIRE(snake.is_alive());
+
+        snake.move(Direction::Right);
+
+        REQUIRE_FALSE(snake.is_alive());
+    }
+}
+
+TEST_CASE("StaticBoard - apples are spawned uniformly on free cells", "[StaticBoard]")
+{
+    StaticBoard<5, 4> board{0, SeededRandomGenerator{40}}; // 4x3 inner cells
+    BasicSnake snake{board, Point{2, 2}, Direction::Up};
+
+    std::map<std::pair<int, int>, int> counts;
+
+    for (int i = 0; i < 20'000; ++i)
+    {
+        board.add_apple();
+        const Point apple = board.apples().back();
+        ++counts[{apple.x, apple.y}];
+        REQUIRE(board.try_eat_apple(apple));
+    }
+
+    REQUIRE(counts.size() == 10);
+    REQUIRE(std::ranges::all_of(counts, [](const auto& count) { return count.second > 1'800 && count.second < 2'200; }));
+
+    SECTION("until the board is full")
+    {
+        for (int i = 0; i < 20; ++i)
+            board.add_apple();
+
+        REQUIRE(board.apples().size() == 10);
+        REQUIRE(board.free_cell_count() == 0);
+    }
+}
+
+namespace
+{
+    // snake circles along the walls - returns number of alive snakes (so the loop is not optimized away)
+    template <typename TBoard>
+    int circle_around(BasicSnake<TBoard>& snake, int ticks)
+    {
+        for (int i = 0; i < ticks; ++i)
+        {
+            const Point head = snake.head();
+            Direction direction = snake.direction();
+
+            if (direction == Direction::Up && head.y == 1)
+                direction = Direction::Right;
+            else if (direction == Direction::Right && head.x == snake.board_.width() - 1)
+                direction = Direction::Down;
+            else if (direction == Direction::Down && head.y == snake.board_.height() - 1)
+                direction = Direction::Left;
+            else if (direction == Direction::Left && head.x == 1)
+                direction = Direction::Up;
+
+            snake.move(direction);
+        }
+
+        return snake.is_alive();
+    }
+}
+
+TEST_CASE("StaticBoard - tick compared with runtime-sized Board", "[.][!benchmark][StaticBoard]")
+{
+    Board board_20x10{20, 10};
+    Snake snake_20x10{board_20x10, {Point{1, 3}, Point{1, 4}, Point{1, 5}, Point{1, 6}}, Direction::Up};
+    StaticBoard<20, 10> static_board_20x10;
+    BasicSnake static_snake_20x10{static_board_20x10, {Point{1, 3}, Point{1, 4}, Point{1, 5}, Point{1, 6}}, Direction::Up};
+
+    Board board_40x30{40, 30};
+    Snake snake_40x30{board_40x30, {Point{1, 3}, Point{1, 4}, Point{1, 5}, Point{1, 6}}, Direction::Up};
+    StaticBoard<40, 30> static_board_40x30;
+    BasicSnake static_snake_40x30{static_board_40x30, {Point{1, 3}, Point{1, 4}, Point{1, 5}, Point{1, 6}}, Direction::Up};
+
+    BENCHMARK("Board 20x10 - 1000 ticks")
+    {
+        return circle_around(snake_20x10, 1000);
+    };
+
+    BENCHMARK("StaticBoard<20, 10> - 1000 ticks")
+    {
+        return circle_around(static_snake_20x10, 1000);
+    };
+
+    BENCHMARK("Board 40x30 - 1000 ticks")
+    {
+        return circle_around(snake_40x30, 1000);
+    };
+
+    BENCHMARK("StaticBoard<40, 30> - 1000 ticks")
+    {
+        return circle_around(static_snake_40x30, 1000);
+    };
+}
+
+TEST_CASE("RingBuffer - pushing to front & popping from back", "[RingBuffer]")
+{
+    RingBuffer<int> buffer;
+
+    for (int i = 1; i <= 5; ++i)
+        buffer.push_front(i);
+
+    SECTION("grows when capacity is exceeded")
+    {
+        REQUIRE(buffer.size() == 5);
+        REQUIRE(buffer.capacity() == 8);
+    }
+
+    SECTION("iterates from front to back")
+    {
+        REQUIRE(std::vector<int>(buffer.begin(), buffer.end()) == std::vector{5, 4, 3, 2, 1});
+    }
+
+    SECTION("keeps order after wrapping around")
+    {
+        for (int i = 6; i <= 20; ++i)
+        {
+            buffer.push_front(i);
+            buffer.pop_back();
+        }
+
+        REQUIRE(buffer.capacity() == 8);
+        REQUIRE(std::vector<int>(buffer.begin(), buffer.end()) == std::vector{20, 19, 18, 17, 16});
+    }
+}
+
+TEST_CASE("Snake - segments view", "[Snake]")
+{
+    Board board{20, 10};
+    Snake snake{board, {Point{5, 5}, Point{5, 6}, Point{5, 7}}, Direction::Up};
+
+    for (int i = 0; i < 3; ++i)
+        snake.move(Direction::Up);
+
+    auto segments = snake.segments();
+
+    SECTION("is split into contiguous parts in head-to-tail order")
+    {
+        auto [first, second] = segments.as_spans();
+
+        std::vector<Point> joined(first.begin(), first.end());
+        joined.insert(joined.end(), second.begin(), second.end());
+
+        REQUIRE(joined == std::vector{Point{5, 2}, Point{5, 3}, Point{5, 4}});
+    }
+
+    SECTION("can be converted to vector")
+    {
+        std::vector<Point> copy = segments;
+
+        REQUIRE(copy == std::vector{Point{5, 2}, Point{5, 3}, Point{5, 4}});
+    }
+}
+
+TEST_CASE("SeededRandomGenerator", "[Random]")
+{
+    SeededRandomGenerator rnd{42};
+
+    SECTION("generates values from the given range")
+    {
+        std::vector<int> values(1000);
+        std::ranges::generate(values, [&rnd] { return rnd(1, 6); });
+
+        REQUIRE(std::ranges::all_of(values, [](int value) { return value >= 1 && value <= 6; }));
+    }
+
+    SECTION("the same seed gives the same sequence")
+    {
+        SeededRandomGenerator other_rnd{42};
+
+        std::vector<int> values(100), other_values(100);
+        std::ranges::generate(values, [&rnd] { return rnd(0, 1000); });
+        std::ranges::generate(other_values, [&other_rnd] { return other_rnd(0, 1000); });
+
+        REQUIRE(values == other_values);
+    }
+
+    SECTION("can be injected into board")
+    {
+        Board board{40, 30, 5, SeededRandomGenerator{7}};
+        Board same_board{40, 30, 5, SeededRandomGenerator{7}};
+
+        REQUIRE(board.apples() == same_board.apples());
+    }
+}
+
+TEST_CASE("BatchSimulation - stepping environments", "[BatchSimulation]")
+{
+    BatchSimulation simulation{4, 20, 10, 42, 2};
+
+    auto observations = simulation.observations();
+    REQUIRE(observations.head_x[0] == 10);
+    REQUIRE(observations.head_y[0] == 5);
+    REQUIRE(observations.length[0] == 2);
+
+    SECTION("snakes move in the given directions")
+    {
+        std::vector actions{Direction::Up, Direction::Left, Direction::Right, Direction::Down};
+        auto result = simulation.step(actions);
+
+        REQUIRE(std::vector(result.observations.head_x.begin(), result.observations.head_x.end()) == std::vector{10, 9, 11, 10});
+        REQUIRE(std::vector(result.observations.head_y.begin(), result.observations.head_y.end()) == std::vector{4, 5, 5, 4});
+        REQUIRE(std::ranges::count(result.dones, 1) == 0);
+    }
+
+    SECTION("when snake hits the wall")
+    {
+        std::vector actions(4, Direction::Up);
+        BatchStepResult result;
+        for (int i = 0; i < 5; ++i)
+            result = simulation.step(actions);
+
+        SECTION("episode is done with negative reward")
+        {
+            REQUIRE(result.dones[0] == 1);
+            REQUIRE(result.rewards[0] == -1.0f);
+        }
+
+        SECTION("environment is reset")
+        {
+            REQUIRE(result.observations.head_y[0] == 5);
+            REQUIRE(result.observations.length[0] == 2);
+        }
+    }
+}
+
+TEST_CASE("BatchSimulation - results do not depend on number of threads", "[BatchSimulation]")
+{
+    const size_t env_count = 64;
+    BatchSimulation single_threaded{env_count, 12, 8, 7, 1};
+    BatchSimulation multi_threaded{env_count, 12, 8, 7, 4};
+
+    SeededRandomGenerator rnd{1};
+    std::vector<Direction> actions(env_count);
+    std::vector<float> total_rewards(env_count), other_total_rewards(env_count);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        std::ranges::generate(actions, [&rnd] { return static_cast<Direction>(rnd(0, 3)); });
+
+        auto result = single_threaded.step(actions);
+        auto other_result = multi_threaded.step(actions);
+
+        for (size_t env = 0; env < env_count; ++env)
+        {
+            total_rewards[env] += result.rewards[env];
+            other_total_rewards[env] += other_result.rewards[env];
+        }
+    }
+
+    REQUIRE(total_rewards == other_total_rewards);
+    REQUIRE(std::ranges::equal(single_threaded.observations().apple_x, multi_threaded.observations().apple_x));
+}
+
+TEST_CASE("BatchSimulation - invalid board sizes are rejected before allocating", "[BatchSimulation]")
+{
+    REQUIRE_THROWS_AS((BatchSimulation{4, 3, 10}), std::invalid_argument);
+    REQUIRE_THROWS_AS((BatchSimulation{1'000'000, 1'000'000, 1'000'000}), std::invalid_argument);
+}
+
+struct ScriptedTerminal : NullTerminal
+{
+    std::vector<std::optional<Key>> keys;
+    size_t index = 0;
+
+    std::optional<Key> read_key()
+    {
+        return index < keys.size() ? keys[index++] : Key::Q;
+    }
+};
+
+TEST_CASE("Replay - recording & replaying a game", "[Replay]")
+{
+    Replay replay{.seed = 2025, .width = 20, .height = 15, .apple_count = 10, .runs = {}};
+
+    ScriptedTerminal scripted_terminal;
+    scripted_terminal.keys = {std::nullopt, Key::P, Key::P, Key::P, Key::ArrowLeft, Key::ArrowLeft, Key::ArrowLeft,
+        std::nullopt, Key::ArrowUp, Key::ArrowUp, Key::ArrowRight, Key::ArrowRight, Key::ArrowRight, Key::ArrowRight,
+        Key::ArrowDown, Key::ArrowDown, Key::ArrowDown, Key::ArrowDown, Key::ArrowDown, Key::ArrowLeft};
+
+    Board board = replay.make_board();
+    Snake snake{board};
+    RecordingTerminal recording_terminal{scripted_terminal, replay};
+    SnakeGame<RecordingTerminal<ScriptedTerminal>, Snake> game{recording_terminal, snake, board};
+    game.run();
+
+    SECTION("keys are run-length encoded")
+    {
+        REQUIRE(replay.tick_count() == scripted_terminal.keys.size() + 1);
+        REQUIRE(replay.runs.size() == 9);
+    }
+
+    SECTION("replay can be serialized")
+    {
+        auto bytes = replay.serialize();
+
+        REQUIRE(Replay::deserialize(bytes) == replay);
+    }
+
+    SECTION("replayed game ends in the same state")
+    {
+        Board replayed_board = replay.make_board();
+        Snake replayed_snake{replayed_board};
+        NullTerminal null_terminal;
+        ReplayingTerminal replaying_terminal{null_terminal, replay};
+        SnakeGame<ReplayingTerminal<NullTerminal>, Snake> replayed_game{replaying_terminal, replayed_snake, replayed_board};
+        replayed_game.run();
+
+        REQUIRE(replayed_snake.segments() == std::vector<Point>(snake.segments()));
+        REQUIRE(replayed_snake.is_alive() == snake.is_alive());
+        REQUIRE(replayed_board.apples() == board.apples());
+    }
+}
+
+TEST_CASE("Replay - invalid input is rejected", "[Replay]")
+{
+    Replay replay{.seed = 1, .width = 20, .height = 10, .apple_count = 0, .runs = {}};
+
+    SECTION("run of no ticks")
+    {
+        replay.runs = {{0, 3}, {1, 0}};
+
+        REQUIRE_THROWS_AS(Replay::deserialize(replay.serialize()), std::runtime_error);
+    }
+
+    SECTION("symbol of no key")
+    {
+        replay.runs = {{7, 1}};
+
+        REQUIRE_THROWS_AS(Replay::deserialize(replay.serialize()), std::runtime_error);
+    }
+
+    SECTION("run longer than 32 bits")
+    {
+        // magic, seed, width, height, apple count, run count, run of no key with continuation, 2^28 << 4 ticks
+        const std::vector<uint8_t> bytes{'S', 'N', 'K', 'R', 1, 20, 10, 0, 1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+
+        REQUIRE_THROWS_AS(Replay::deserialize(bytes), std::runtime_error);
+    }
+}
+
+TEST_CASE("FixedTimestepScheduler - planning frames", "[FixedTimestepScheduler]")
+{
+    using namespace std::chrono_literals;
+
+    const auto start = FixedTimestepScheduler::Clock::now();
+    FixedTimestepScheduler scheduler{75ms, 20ms, 3, start};
+
+    SECTION("first frame updates & renders")
+    {
+        auto frame = scheduler.plan_frame(start);
+
+        REQUIRE(frame.updates == 1);
+        REQUIRE(frame.render);
+    }
+
+    SECTION("rendering is paced independently from updates")
+    {
+        scheduler.plan_frame(start);
+        auto frame = scheduler.plan_frame(start + 20ms);
+
+        REQUIRE(frame.updates == 0);
+        REQUIRE(frame.render);
+        REQUIRE(scheduler.next_deadline() == start + 40ms);
+    }
+
+    SECTION("missed updates are caught up in fixed steps")
+    {
+        scheduler.plan_frame(start);
+        auto frame = scheduler.plan_frame(start + 150ms);
+
+        REQUIRE(frame.updates == 2);
+    }
+
+    SECTION("number of updates in one frame is limited")
+    {
+        scheduler.plan_frame(start);
+        auto frame = scheduler.plan_frame(start + 10s);
+
+        REQUIRE(frame.updates == 3);
+        REQUIRE(scheduler.next_deadline() > start + 10s);
+    }
+}
+
+TEST_CASE("Autopilot - choosing direction", "[Autopilot]")
+{
+    auto stub_rnd = [values = std::vector{4, 6}, index = 0](int, int) mutable {
+        return values[index++ % 2];
+    };
+
+    Board board{20, 10, 1, stub_rnd};
+    REQUIRE(board.apples() == std::vector{Point{4, 6}});
+
+    Snake snake{board, Point{10, 6}, Direction::Up};
+    Autopilot autopilot{board, snake};
+
+    SECTION("heads towards the nearest apple")
+    {
+        REQUIRE(autopilot.next_direction() == Direction::Left);
+    }
+
+    SECTION("distance field ignores the snake's body")
+    {
+        REQUIRE(autopilot.next_direction() == Direction::Left);
+        REQUIRE(autopilot.distance_to_apple(Point{10, 6}) == 6);
+    }
+
+    SECTION("reachable apple is eaten along the shortest path")
+    {
+        size_t moves = 0;
+        while (snake.segments().size() == 2 && moves < 100)
+        {
+            snake.move(autopilot.next_direction());
+            REQUIRE(snake.is_alive());
+            ++moves;
+        }
+
+        REQUIRE(moves == 6);
+    }
+}
+
+TEST_CASE("Autopilot - reaching apple in the corner left out of the cycle", "[Autopilot]")
+{
+    auto stub_rnd = [values = std::vector{1, 5}, index = 0](int, int) mutable {
+        return values[index++ % 2];
+    };
+
+    Board board{6, 6, 1, stub_rnd};
+    REQUIRE(board.apples() == std::vector{Point{1, 5}});
+
+    Snake snake{board};
+    Autopilot autopilot{board, snake};
+
+    size_t moves = 0;
+    while (snake.segments().size() == 2 && moves < 100)
+    {
+        snake.move(autopilot.next_direction());
+        REQUIRE(snake.is_alive());
+        ++moves;
+    }
+
+    REQUIRE(moves <= 5 * 5);
+}
+
+TEST_CASE("Autopilot - filling a small board", "[Autopilot]")
+{
+    auto [width, height] = GENERATE(table<int, int>({{6, 5}, {7, 6}, {6, 6}, {7, 7}}));
+    const auto seed = GENERATE(range(uint64_t{1}, uint64_t{51}));
+    const size_t inner_cells = static_cast<size_t>(width - 1) * static_cast<size_t>(height - 1);
+
+    Board board{width, height, 1, SeededRandomGenerator{seed}};
+    Snake snake{board};
+    Autopilot autopilot{board, snake};
+
+    // apples left on the cycle are reached within one lap - the snake never circles without eating
+    size_t moves_since_apple = 0;
+    while (board.free_cell_count() > 0)
+    {
+        const size_t length = snake.segments().size();
+        snake.move(autopilot.next_direction());
+
+        REQUIRE(snake.is_alive());
+        moves_since_apple = snake.segments().size() > length ? 0 : moves_since_apple + 1;
+        REQUIRE(moves_since_apple <= inner_cells);
+    }
+
+    REQUIRE(snake.segments().size() + board.apples().size() == inner_cells);
+}
+
+TEST_CASE("Autopilot - Hamiltonian cycle visits inner cells", "[Autopilot]")
+{
+    auto [width, height, expected_length] = GENERATE(table<int, int, size_t>({{20, 11, 190}, {21, 10, 180}, {40, 30, 39 * 29 - 1}}));
+
+    Board board{width, height};
+    Snake snake{board};
+    Autopilot autopilot{board, snake};
+
+    std::set<std::pair<int, int>> visited;
+    Point pt{1, 1};
+    do
+    {
+        REQUIRE(visited.insert({pt.x, pt.y}).second);
+
+        auto direction = autopilot.cycle_direction(pt);
+        REQUIRE(direction.has_value());
+
+        switch (*direction)
+        {
+        case Direction::Up: --pt.y; break;
+        case Direction::Down: ++pt.y; break;
+        case Direction::Left: --pt.x; break;
+        case Direction::Right: ++pt.x; break;
+        }
+        REQUIRE_FALSE(board.is_hitting_walls(pt));
+    } while (pt != Point{1, 1});
+
+    REQUIRE(visited.size() == expected_length);
+}
+
+TEST_CASE("Autopilot - playing the game", "[Autopilot]")
+{
+    Board board{30, 20, 3, SeededRandomGenerator{11}};
+    Snake snake{board};
+    Autopilot autopilot{board, snake};
+
+    NullTerminal null_terminal;
+    AutopilotTerminal autopilot_terminal{null_terminal, autopilot, 500};
+    SnakeGame<AutopilotTerminal<NullTerminal>, Snake> game{autopilot_terminal, snake, board};
+    game.run();
+
+    REQUIRE(snake.segments().size() > 2);
+}
+
+TEST_CASE("SnakeSwarm - resolving collisions", "[SnakeSwarm]")
+{
+    Board board{20, 20};
+    SnakeSwarm swarm{board, 2};
+
+    SECTION("snakes moving into the same cell die & are taken off the board")
+    {
+        swarm.add_snake(Point{5, 5}, Direction::Right);
+        swarm.add_snake(Point{7, 5}, Direction::Left);
+        swarm.add_snake(Point{15, 15}, Direction::Up);
+
+        swarm.step(std::vector{Direction::Right, Direction::Left, Direction::Up});
+
+        REQUIRE_FALSE(swarm.snake(0).is_alive());
+        REQUIRE_FALSE(swarm.snake(1).is_alive());
+        REQUIRE(swarm.snake(2).is_alive());
+        REQUIRE_FALSE(board.has_snake_segment(Point{5, 5}));
+        REQUIRE_FALSE(board.has_snake_segment(Point{7, 5}));
+        REQUIRE(swarm.alive_count() == 1);
+    }
+
+    SECTION("snake moving into other snake's body dies")
+    {
+        swarm.add_snake(Point{5, 5}, Direction::Up);
+        swarm.add_snake(Point{4, 6}, Direction::Right);
+
+        swarm.step(std::vector{Direction::Up, Direction::Right});
+
+        REQUIRE(swarm.snake(0).is_alive());
+        REQUIRE(swarm.snake(0).segments() == std::vector{Point{5, 4}, Point{5, 5}});
+        REQUIRE_FALSE(swarm.snake(1).is_alive());
+    }
+
+    SECTION("snake following another one hits its tail")
+    {
+        swarm.add_snake(Point{5, 5}, Direction::Right);
+        swarm.add_snake(Point{3, 5}, Direction::Right);
+
+        swarm.step(std::vector{Direction::Right, Direction::Right});
+
+        REQUIRE(swarm.snake(0).is_alive());
+        REQUIRE_FALSE(swarm.snake(1).is_alive()); // tail of the first snake is still there in the first phase
+    }
+}
+
+TEST_CASE("SnakeSwarm - results do not depend on number of threads", "[SnakeSwarm]")
+{
+    Board board{200, 200, 500, SeededRandomGenerator{3}};
+    Board other_board{200, 200, 500, SeededRandomGenerator{3}};
+    SnakeSwarm swarm{board, 1};
+    SnakeSwarm other_swarm{other_board, 4};
+
+    for (int y = 10; y < 190; y += 6)
+        for (int x = 10; x < 190; x += 6)
+        {
+            swarm.add_snake(Point{x, y}, Direction::Up);
+            other_swarm.add_snake(Point{x, y}, Direction::Up);
+        }
+
+    SeededRandomGenerator rnd{5};
+    std::vector<Direction> directions(swarm.size());
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::ranges::generate(directions, [&rnd] { return static_cast<Direction>(rnd(0, 3)); });
+
+        swarm.step(directions);
+        other_swarm.step(directions);
+    }
+
+    REQUIRE(swarm.alive_count() > 0);
+    REQUIRE(swarm.alive_count() < swarm.size());
+    REQUIRE(board.apples() == other_board.apples());
+    for (size_t i = 0; i < swarm.size(); ++i)
+        REQUIRE(swarm.snake(i).segments() == std::vector<Point>(other_swarm.snake(i).segments()));
+}
+
+TEST_CASE("Snapshot - restoring board, snake & game", "[Snapshot]")
+{
+    Board board{20, 10, 5, SeededRandomGenerator{41}};
+    Snake snake{board};
+    NullTerminal terminal;
+    SnakeGame<NullTerminal, Snake> game{terminal, snake, board};
+    game.restore({SnakeGame<NullTerminal, Snake>::GameState::Playing, Key::ArrowLeft, Direction::Left});
+
+    Snapshot snapshot;
+    snapshot.save(board, snake, game);
+
+    const auto moves = std::vector{Direction::Left, Direction::Up, Direction::Up, Direction::Right, Direction::Right,
+        Direction::Down, Direction::Left, Direction::Left, Direction::Up, Direction::Right};
+
+    auto play = [&] {
+        std::vector<std::vector<Point>> history;
+        for (auto direction : moves)
+        {
+            snake.move(direction);
+            history.push_back(snake.segments());
+        }
+        history.push_back(board.apples());
+        return history;
+    };
+
+    const auto history = play();
+    const Point head_after_moves = snake.head();
+
+    game.restore({SnakeGame<NullTerminal, Snake>::GameState::GameOver, std::nullopt, Direction::Up});
+    snapshot.restore(board, snake, game);
+
+    SECTION("state is restored")
+    {
+        REQUIRE(game.state() == SnakeGame<NullTerminal, Snake>::State{SnakeGame<NullTerminal, Snake>::GameState::Playing, Key::ArrowLeft, Direction::Left});
+        REQUIRE(snake.segments() == std::vector{Point{10, 5}, Point{10, 6}});
+        REQUIRE(board.has_snake_segment(Point{10, 6}));
+        REQUIRE_FALSE(board.has_snake_segment(head_after_moves));
+        REQUIRE(board.free_cell_count() == 19 * 9 - 2 - board.apples().size());
+    }
+
+    SECTION("game continues exactly the same way - random generator included")
+    {
+        REQUIRE(play() == history);
+    }
+}
+
+TEST_CASE("Snapshot - restoring touches only changed cells of a large board", "[Snapshot]")
+{
+    Board board{2000, 2000, 50, SeededRandomGenerator{43}};
+    Snake snake{board, Point{1000, 1000}, Direction::Left};
+
+    Snapshot snapshot;
+    snapshot.save(board, snake);
+    const auto apples = board.apples();
+    const std::vector<Point> segments = snake.segments();
+
+    // apples are eaten, so both the apple list & the free cells change
+    for (const auto& apple : std::vector(apples.begin(), apples.begin() + 3))
+    {
+        board.try_eat_apple(apple);
+        board.add_apple();
+        board.add_apple();
+    }
+    for (int i = 0; i < 200; ++i)
+        snake.move(i % 50 < 25 ? Direction::Left : Direction::Up);
+
+    const std::vector<Point> moved_segments = snake.segments();
+    const auto moved_apples = board.apples();
+
+    snapshot.restore(board, snake);
+
+    REQUIRE(board.apples() == apples);
+    REQUIRE(snake.segments() == segments);
+    REQUIRE(board.free_cell_count() == 1999 * 1999 - segments.size() - apples.size());
+
+    REQUIRE(std::ranges::all_of(apples, [&](const Point& apple) { return board.has_apple(apple); }));
+    REQUIRE(std::ranges::all_of(segments, [&](const Point& segment) { return board.has_snake_segment(segment); }));
+    REQUIRE(std::ranges::none_of(moved_segments, [&](const Point& segment) {
+        return board.has_snake_segment(segment) && std::ranges::find(segments, segment) == segments.end();
+    }));
+    REQUIRE(std::ranges::none_of(moved_apples, [&](const Point& apple) {
+        return board.has_apple(apple) && std::ranges::find(apples, apple) == apples.end();
+    }));
+}
+
+TEST_CASE("Snapshot - crowded board continues the same way after restoring", "[Snapshot]")
+{
+    // on a crowded board most apples are placed through the free-cell index
+    for (uint64_t seed = 1; seed <= 32; ++seed)
+    {
+        Board board{6, 5, 4, SeededRandomGenerator{seed}};
+        Snake snake{board};
+        circle_around(snake, 5);
+
+        Snapshot snapshot;
+        snapshot.save(board, snake);
+
+        auto play = [&] {
+            std::vector<std::vector<Point>> history;
+            for (int i = 0; i < 20 && snake.is_alive(); ++i)
+            {
+                circle_around(snake, 1);
+                history.push_back(board.apples());
+            }
+            return history;
+        };
+
+        const auto history = play();
+        snapshot.restore(board, snake);
+
+        REQUIRE(play() == history);
+    }
+}
+
+TEST_CASE("RollbackRing - rewinding ticks", "[Snapshot]")
+{
+    Board board{20, 10, 10, SeededRandomGenerator{41}};
+    Snake snake{board};
+    RollbackRing ring{8};
+
+    std::vector<std::vector<Point>> segments_history;
+    for (int i = 0; i < 20; ++i)
+    {
+        ring.save(board, snake);
+        segments_history.push_back(snake.segments());
+        snake.move(i % 8 < 4 ? Direction::Left : Direction::Up);
+    }
+
+    REQUIRE(ring.size() == 8);
+
+    SECTION("restores state from given number of ticks back")
+    {
+        ring.rewind(3, board, snake);
+
+        REQUIRE(snake.segments() == segments_history[20 - 1 - 3]);
+        REQUIRE(ring.size() == 5);
+    }
+
+    SECTION("keeps only the last snapshots")
+    {
+        REQUIRE_THROWS_AS(ring.rewind(8, board, snake), std::out_of_range);
+    }
+}
+
+TEST_CASE("FrameTimings - percentiles of phases", "[FrameTimings]")
+{
+    FrameTimings timings;
+
+    SECTION("small durations are exact")
+    {
+        for (uint64_t ns = 1; ns <= 10; ++ns)
+            timings.record(FramePhase::Update, ns);
+
+        const auto& histogram = timings.histogram(FramePhase::Update);
+        REQUIRE(histogram.count() == 10);
+        REQUIRE(histogram.percentile(0.5) == 5);
+        REQUIRE(histogram.percentile(1.0) == 10);
+        REQUIRE(timings.last(FramePhase::Update) == 10);
+        REQUIRE(timings.histogram(FramePhase::Render).percentile(0.5) == 0);
+    }
+
+    SECTION("large durations are within 12.5%")
+    {
+        for (int i = 0; i < 98; ++i)
+            timings.record(FramePhase::Flush, 1'000'000);
+        timings.record(FramePhase::Flush, 5'000'000);
+        timings.record(FramePhase::Flush, 9'000'000);
+
+        const auto& histogram = timings.histogram(FramePhase::Flush);
+        REQUIRE(histogram.percentile(0.5) >= 1'000'000);
+        REQUIRE(histogram.percentile(0.5) <= 1'125'000);
+        REQUIRE(histogram.percentile(0.99) >= 5'000'000);
+        REQUIRE(histogram.percentile(0.99) <= 5'625'000);
+        REQUIRE(histogram.max() == 9'000'000);
+    }
+
+    SECTION("timer records its scope")
+    {
+        {
+            PhaseTimer<true> timer{FramePhase::ReadKey, timings};
+            std::this_thread::sleep_for(1ms);
+        }
+
+        REQUIRE(timings.histogram(FramePhase::ReadKey).count() == 1);
+        REQUIRE(timings.last(FramePhase::ReadKey) >= 1'000'000);
+    }
+
+    SECTION("dump lists p50 & p99 of every phase")
+    {
+        timings.record(FramePhase::Render, 2'000);
+
+        std::ostringstream out;
+        timings.dump(out);
+
+        REQUIRE(out.str().find("p99") != std::string::npos);
+        REQUIRE(out.str().find("render             1         2.0         2.0         2.0") != std::string::npos);
+    }
+}
+
+TEST_CASE("SpectatorFeed - watching ticks through shared memory", "[SpectatorFeed]")
+{
+    const std::string feed_name = "/snake-tests-" + std::to_string(getpid());
+
+    Board board{20, 10, 5, SeededRandomGenerator{43}};
+    Snake snake{board};
+    SpectatorPublisher publisher{feed_name, 4};
+    SpectatorReader reader{feed_name};
+    SpectatorFrame frame;
+
+    SECTION("nothing is read before the first tick")
+    {
+        REQUIRE_FALSE(reader.read_latest(frame));
+        REQUIRE_FALSE(reader.read(0, frame));
+    }
+
+    SECTION("reader gets the latest tick")
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            circle_around(snake, 1);
+            publisher.publish(board, snake);
+        }
+
+        REQUIRE(reader.read_latest(frame));
+        REQUIRE(frame.tick == 2);
+        REQUIRE(frame.width == 20);
+        REQUIRE(frame.height == 10);
+        REQUIRE(frame.direction == snake.direction());
+        REQUIRE(frame.is_alive);
+        REQUIRE(frame.snake == std::vector<Point>(snake.segments().begin(), snake.segments().end()));
+        REQUIRE(frame.apples == board.apples());
+    }
+
+    SECTION("live feed is not taken over by another publisher")
+    {
+        publisher.publish(board, snake);
+
+        REQUIRE_THROWS_AS(SpectatorPublisher(feed_name, 4), std::system_error);
+        REQUIRE(reader.read_latest(frame));
+        REQUIRE(frame.tick == 0);
+    }
+
+    SECTION("overwritten ticks are not read")
+    {
+        for (int i = 0; i < 6; ++i)
+            publisher.publish(board, snake);
+
+        REQUIRE_FALSE(reader.read(1, frame));
+        REQUIRE(reader.read(2, frame));
+        REQUIRE_FALSE(reader.read(6, frame));
+    }
+
+    SECTION("frames read while publishing are never torn")
+    {
+        // expected heads & lengths - the same game is replayed by the publisher
+        Board expected_board{20, 10, 5, SeededRandomGenerator{43}};
+        Snake expected_snake{expected_board};
+        std::vector<std::pair<Point, size_t>> expected;
+        for (int i = 0; i < 2000 && expected_snake.is_alive(); ++i)
+        {
+            circle_around(expected_snake, 1);
+            expected.emplace_back(expected_snake.head(), expected_snake.segments().size());
+        }
+
+        // halfway the publisher waits for a frame read before the last tick, so reads overlap publishing
+        std::atomic<size_t> reads_while_publishing{0};
+        std::jthread game{[&] {
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                if (i == expected.size() / 2)
+                {
+                    while (reads_while_publishing.load() == 0)
+                        std::this_thread::yield();
+                }
+
+                circle_around(snake, 1);
+                publisher.publish(board, snake);
+                std::this_thread::yield();
+            }
+        }};
+
+        while (reader.published() < expected.size())
+        {
+            if (!reader.read_latest(frame))
+                continue;
+
+            REQUIRE(frame.snake.front() == expected[frame.tick].first);
+            REQUIRE(frame.snake.size() == expected[frame.tick].second);
+
+            if (frame.tick + 1 < expected.size())
+                ++reads_while_publishing;
+        }
+
+        REQUIRE(reads_while_publishing.load() > 0);
+
+        REQUIRE(reader.read_latest(frame));
+        REQUIRE(frame.tick == expected.size() - 1);
+    }
+}
+
+TEST_CASE("KeyQueue - key presses consumed one per tick", "[KeyQueue]")
+{
+    using namespace std::chrono_literals;
+
+    KeyQueue<4> keys;
+    const auto start = KeyQueue<4>::Clock::now();
+
+    SECTION("keys are popped in order of presses")
+    {
+        keys.push(Key::ArrowLeft, start);
+        keys.push(Key::ArrowUp, start + 1ms);
+
+        REQUIRE(keys.pop(start + 2ms) == Key::ArrowLeft);
+        REQUIRE(keys.pop(start + 2ms) == Key::ArrowUp);
+        REQUIRE(keys.pop(start + 2ms) == std::nullopt);
+    }
+
+    SECTION("presses over capacity are dropped")
+    {
+        for (int i = 0; i < 6; ++i)
+            keys.push(i % 2 ? Key::ArrowUp : Key::ArrowDown, start);
+
+        REQUIRE(keys.size() == 4);
+        REQUIRE(keys.dropped() == 2);
+        REQUIRE(keys.pop(start) == Key::ArrowDown);
+    }
+
+    SECTION("time from press to turn is recorded")
+    {
+        keys.push(Key::ArrowRight, start);
+        keys.pop(start + 75ms);
+
+        REQUIRE(keys.latency().count() == 1);
+        REQUIRE(keys.latency().percentile(0.5) >= 75'000'000);
+        REQUIRE(keys.latency().percentile(0.5) <= 75'000'000 * 9 / 8);
+    }
+}
+
+TEST_CASE("RolloutBot - choosing moves by playouts", "[RolloutBot]")
+{
+    RolloutSettings settings;
+    settings.time_budget = 10s;
+    settings.max_playouts = 300;
+    settings.depth = 30;
+
+    SECTION("avoids a move into the wall")
+    {
+        Board board{10, 10, 0, SeededRandomGenerator{45}};
+        Snake snake{board, Point{1, 5}, Direction::Left};
+        RolloutBot bot{board, snake, settings, 1};
+
+        const auto direction = bot.next_direction();
+
+        REQUIRE((direction == Direction::Up || direction == Direction::Down));
+        REQUIRE(bot.last_playouts() == 300);
+    }
+
+    SECTION("plays the game with many threads")
+    {
+        Board board{40, 30, 5, SeededRandomGenerator{45}};
+        Snake snake{board};
+        RolloutBot bot{board, snake, settings, 4};
+
+        for (int i = 0; i < 100 && snake.is_alive(); ++i)
+        {
+            snake.move(bot.next_direction());
+            REQUIRE(bot.last_playouts() == 300);
+        }
+
+        REQUIRE(snake.is_alive());
+        REQUIRE(snake.segments().size() > 2);
+    }
+    SECTION("moves on a crowded board do not depend on the number of threads")
+    {
+        // most apples in playouts are placed through the free-cell index
+        settings.max_playouts = 200;
+        for (uint64_t seed = 1; seed <= 10; ++seed)
+        {
+            settings.seed = seed;
+
+            Board board{7, 6, 12, SeededRandomGenerator{seed}};
+            Snake snake{board};
+            RolloutBot bot{board, snake, settings, 1};
+
+            Board other_board{7, 6, 12, SeededRandomGenerator{seed}};
+            Snake other_snake{other_board};
+            RolloutBot other_bot{other_board, other_snake, settings, 4};
+
+            for (int i = 0; i < 20 && snake.is_alive(); ++i)
+            {
+                const auto direction = bot.next_direction();
+                REQUIRE(other_bot.next_direction() == direction);
+
+                snake.move(direction);
+                other_snake.move(direction);
+            }
+        }
+    }
+
+    SECTION("moves do not depend on the number of threads")
+    {
+        Board board{40, 30, 5, SeededRandomGenerator{46}};
+        Snake snake{board};
+        RolloutBot bot{board, snake, settings, 1};
+
+        Board other_board{40, 30, 5, SeededRandomGenerator{46}};
+        Snake other_snake{other_board};
+        RolloutBot other_bot{other_board, other_snake, settings, 4};
+
+        for (int i = 0; i < 30 && snake.is_alive(); ++i)
+        {
+            const auto direction = bot.next_direction();
+            REQUIRE(other_bot.next_direction() == direction);
+
+            snake.move(direction);
+            other_snake.move(direction);
+        }
+    }
+}